@@ -0,0 +1,162 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <SFML/Graphics.hpp>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "TextureCache.h"
+
+using namespace sf;
+using namespace std;
+
+// What a character is doing, as far as its sprite is concerned
+enum AnimationState {
+    ANIM_STAND = 0,
+    ANIM_RUN,
+    ANIM_BALL,
+    ANIM_FLY,
+    ANIM_STATE_COUNT
+};
+
+// One animation: a sheet of equally wide frames side by side, played in order
+struct AnimationClip {
+    TextureRegion sheet;
+    int frameCount;
+    float frameDuration;    // Seconds per frame (0 = a still)
+
+    IntRect frameRect(int frame) const {
+        int frameWidth = sheet.rect.width / frameCount;
+        return IntRect(sheet.rect.left + frame * frameWidth, sheet.rect.top, frameWidth, sheet.rect.height);
+    }
+};
+
+// Plays a character's clips on its sprite. The clips come from the animation manifest:
+//
+//   clip <character> <state> <sheet image> <frames> <frames per second>
+//
+// Every sheet is acquired once when the character is created; after that a state
+// change or a new frame only sets the sprite's texture rect (and its texture pointer,
+// if the clip's sheet is a different texture - with the atlas they share a page).
+class Animator {
+public:
+    static constexpr const char* MANIFEST_FILE = "Data/animations.txt";
+
+private:
+    AnimationClip clips[ANIM_STATE_COUNT];
+    bool hasClip[ANIM_STATE_COUNT];
+    Sprite* sprite;
+    AnimationState state;
+    int frame;
+    float frameTimer;
+
+    static bool parseState(const string& name, AnimationState& out) {
+        static const char* const names[ANIM_STATE_COUNT] = { "stand", "run", "ball", "fly" };
+        for (int i = 0; i < ANIM_STATE_COUNT; i++) {
+            if (name == names[i]) {
+                out = static_cast<AnimationState>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // States without a clip of their own use the standing one
+    AnimationState resolve(AnimationState wanted) const {
+        return hasClip[wanted] ? wanted : ANIM_STAND;
+    }
+
+    void showFrame(bool newSheet) {
+        const AnimationClip& clip = clips[state];
+        if (!hasClip[state] || !clip.sheet.texture) return;
+        if (newSheet && sprite->getTexture() != clip.sheet.texture.get()) {
+            sprite->setTexture(*clip.sheet.texture);
+        }
+        sprite->setTextureRect(clip.frameRect(frame));
+    }
+
+public:
+    Animator() : sprite(nullptr), state(ANIM_STAND), frame(0), frameTimer(0) {
+        for (int i = 0; i < ANIM_STATE_COUNT; i++) {
+            hasClip[i] = false;
+        }
+    }
+
+    // Load a character's clips (e.g. "sonic") and show its standing frame on target
+    bool load(const string& character, Sprite& target) {
+        sprite = &target;
+        ifstream file(MANIFEST_FILE);
+        if (!file.is_open()) {
+            cout << "Failed to open animation manifest: " << MANIFEST_FILE << endl;
+            return false;
+        }
+
+        bool loaded = true;
+        string line;
+        while (getline(file, line)) {
+            if (line.empty() || line[0] == '#') continue;
+
+            istringstream in(line);
+            string kind, owner, stateName, sheet;
+            int frames;
+            float framesPerSecond;
+            if (!(in >> kind >> owner >> stateName >> sheet >> frames >> framesPerSecond) || kind != "clip" || owner != character) {
+                continue;
+            }
+            AnimationState clipState;
+            if (!parseState(stateName, clipState) || frames < 1) {
+                cout << "Bad animation clip: " << line << endl;
+                continue;
+            }
+
+            AnimationClip& clip = clips[clipState];
+            if (!TextureCache::getInstance().acquireRegion(sheet, clip.sheet)) {
+                cout << "Failed to load animation sheet: " << sheet << endl;
+                loaded = false;
+            }
+            clip.frameCount = frames;
+            clip.frameDuration = framesPerSecond > 0 ? 1.0f / framesPerSecond : 0.0f;
+            hasClip[clipState] = true;
+        }
+        if (!hasClip[ANIM_STAND]) {
+            cout << "No standing animation for " << character << endl;
+            return false;
+        }
+
+        state = ANIM_STAND;
+        frame = 0;
+        frameTimer = 0;
+        showFrame(true);
+        return loaded;
+    }
+
+    // Called once per tick: switch to the wanted state's clip (from its first frame)
+    // or advance the current one by deltaTime
+    void update(AnimationState wanted, float deltaTime) {
+        if (!sprite) return;
+        wanted = resolve(wanted);
+        if (wanted != state) {
+            state = wanted;
+            frame = 0;
+            frameTimer = 0;
+            showFrame(true);
+            return;
+        }
+
+        const AnimationClip& clip = clips[state];
+        if (clip.frameCount < 2 || clip.frameDuration <= 0) return;
+        frameTimer += deltaTime;
+        if (frameTimer < clip.frameDuration) return;
+        while (frameTimer >= clip.frameDuration) {
+            frameTimer -= clip.frameDuration;
+            frame = (frame + 1) % clip.frameCount;
+        }
+        showFrame(false);
+    }
+
+    AnimationState getState() const { return state; }
+    int getFrame() const { return frame; }
+};
+
+#endif // ANIMATION_H
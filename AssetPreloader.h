@@ -0,0 +1,209 @@
+#ifndef ASSET_PRELOADER_H
+#define ASSET_PRELOADER_H
+
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Trace.h"
+
+using namespace sf;
+using namespace std;
+
+// Decodes startup assets on a small pool of worker threads while the window opens and
+// the intro plays. Request files early, then load them where they are used:
+//
+//     AssetPreloader::getInstance().requestImage("Data/title_screen.gif");
+//     ...
+//     AssetPreloader::getInstance().loadTexture("Data/title_screen.gif", texture);
+//
+// A load waits for its file's decode if it is still running and only does the GPU /
+// audio device part on the calling thread. Files that were never requested are loaded
+// directly, so every load works with or without a request.
+class AssetPreloader {
+private:
+    enum AssetKind {
+        ASSET_IMAGE,    // Decoded to an Image
+        ASSET_SOUND,    // Decoded to 16-bit samples
+        ASSET_FILE      // Raw bytes (fonts, which SFML reads from memory on demand)
+    };
+
+    struct Asset {
+        AssetKind kind;
+        string filename;
+        bool done;                  // Set under the lock once the fields below are filled in
+        bool loaded;
+        Image image;
+        vector<Int16> samples;
+        unsigned channelCount;
+        unsigned sampleRate;
+        vector<char> bytes;
+    };
+
+    map<string, unique_ptr<Asset>> assets;
+    deque<Asset*> queue;
+    vector<thread> workers;
+    mutex lock;
+    condition_variable workAvailable;
+    condition_variable assetDone;
+    bool stopping;
+
+    AssetPreloader() : stopping(false) {}
+    AssetPreloader(const AssetPreloader&) = delete;
+    AssetPreloader& operator=(const AssetPreloader&) = delete;
+
+    ~AssetPreloader() {
+        shutdown();
+    }
+
+    static void decode(Asset& asset) {
+        TRACE_SCOPE_DETAIL("load", "decode", asset.filename.c_str());
+        if (asset.kind == ASSET_IMAGE) {
+            asset.loaded = asset.image.loadFromFile(asset.filename);
+        }
+        else if (asset.kind == ASSET_SOUND) {
+            InputSoundFile file;
+            asset.loaded = file.openFromFile(asset.filename);
+            if (asset.loaded) {
+                asset.samples.resize(static_cast<size_t>(file.getSampleCount()));
+                asset.samples.resize(static_cast<size_t>(file.read(asset.samples.data(), asset.samples.size())));
+                asset.channelCount = file.getChannelCount();
+                asset.sampleRate = file.getSampleRate();
+            }
+        }
+        else {
+            ifstream in(asset.filename, ios::binary);
+            asset.loaded = in.is_open();
+            if (asset.loaded) {
+                asset.bytes.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+            }
+        }
+    }
+
+    void workerLoop() {
+        TRACE_THREAD_NAME("asset worker");
+        unique_lock<mutex> guard(lock);
+        while (true) {
+            workAvailable.wait(guard, [this] { return stopping || !queue.empty(); });
+            if (stopping) return;
+            Asset* asset = queue.front();
+            queue.pop_front();
+            guard.unlock();
+            decode(*asset);
+            guard.lock();
+            asset->done = true;
+            assetDone.notify_all();
+        }
+    }
+
+    void request(AssetKind kind, const string& filename) {
+        {
+            lock_guard<mutex> guard(lock);
+            if (stopping || assets.count(filename)) return;
+            if (workers.empty()) {
+                // Leave a core for the main thread
+                unsigned cores = thread::hardware_concurrency();
+                int count = max(1, min(4, static_cast<int>(cores) - 1));
+                for (int i = 0; i < count; i++) {
+                    workers.push_back(thread(&AssetPreloader::workerLoop, this));
+                }
+            }
+            unique_ptr<Asset> asset(new Asset());
+            asset->kind = kind;
+            asset->filename = filename;
+            asset->done = false;
+            asset->loaded = false;
+            asset->channelCount = 0;
+            asset->sampleRate = 0;
+            queue.push_back(asset.get());
+            assets[filename] = move(asset);
+        }
+        workAvailable.notify_one();
+    }
+
+    // The requested asset once decoded (waiting for it if needed), nullptr if never requested
+    Asset* waitFor(const string& filename, AssetKind kind) {
+        unique_lock<mutex> guard(lock);
+        map<string, unique_ptr<Asset>>::iterator it = assets.find(filename);
+        if (it == assets.end() || it->second->kind != kind) return nullptr;
+        Asset* asset = it->second.get();
+        if (!asset->done) {
+            TRACE_SCOPE_DETAIL("load", "wait for decode", filename.c_str());
+            assetDone.wait(guard, [asset] { return asset->done; });
+        }
+        return asset;
+    }
+
+    // Images and sounds are only needed until they are loaded
+    void discard(const string& filename) {
+        lock_guard<mutex> guard(lock);
+        assets.erase(filename);
+    }
+
+public:
+    static AssetPreloader& getInstance() {
+        static AssetPreloader instance;
+        return instance;
+    }
+
+    // Start decoding a file in the background (ignored if already requested)
+    void requestImage(const string& filename) { request(ASSET_IMAGE, filename); }
+    void requestSound(const string& filename) { request(ASSET_SOUND, filename); }
+    void requestFont(const string& filename) { request(ASSET_FILE, filename); }
+
+    // Upload a (requested) image to a texture
+    bool loadTexture(const string& filename, Texture& texture) {
+        Asset* asset = waitFor(filename, ASSET_IMAGE);
+        if (!asset) return texture.loadFromFile(filename);
+        bool loaded = asset->loaded && texture.loadFromImage(asset->image);
+        discard(filename);
+        return loaded;
+    }
+
+    // Fill a sound buffer from (requested) decoded samples
+    bool loadSound(const string& filename, SoundBuffer& buffer) {
+        Asset* asset = waitFor(filename, ASSET_SOUND);
+        if (!asset) return buffer.loadFromFile(filename);
+        bool loaded = asset->loaded && !asset->samples.empty()
+            && buffer.loadFromSamples(asset->samples.data(), asset->samples.size(), asset->channelCount, asset->sampleRate);
+        discard(filename);
+        return loaded;
+    }
+
+    // Open a font from its (requested) file contents, which are kept for as long as
+    // the program runs since the font reads glyphs from them on demand
+    bool loadFont(const string& filename, Font& font) {
+        Asset* asset = waitFor(filename, ASSET_FILE);
+        if (!asset) return font.loadFromFile(filename);
+        return asset->loaded && !asset->bytes.empty() && font.loadFromMemory(asset->bytes.data(), asset->bytes.size());
+    }
+
+    // Stop the workers. Decodes still queued are dropped; loading one of those files
+    // afterwards reads it directly.
+    void shutdown() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+            for (size_t i = 0; i < queue.size(); i++) {
+                assets.erase(queue[i]->filename);
+            }
+            queue.clear();
+        }
+        workAvailable.notify_all();
+        for (size_t i = 0; i < workers.size(); i++) {
+            workers[i].join();
+        }
+        workers.clear();
+    }
+};
+
+#endif // ASSET_PRELOADER_H
@@ -0,0 +1,225 @@
+#ifndef AUDIO_MANAGER_H
+#define AUDIO_MANAGER_H
+
+#include <SFML/Audio.hpp>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include "Trace.h"
+
+using namespace sf;
+using namespace std;
+
+// Priority of a sound effect - a new sound may only steal a voice of equal or lower priority
+enum SoundPriority {
+    SOUND_PRIORITY_LOW = 0,
+    SOUND_PRIORITY_NORMAL = 1,
+    SOUND_PRIORITY_HIGH = 2
+};
+
+// Central audio subsystem shared by the whole game.
+// Sound effects are decoded once into a SoundBuffer cache and played through a fixed
+// pool of Sound voices; only the zone background music is streamed.
+// The voices and the music stream (which open the audio device) are only created
+// while audio is enabled; call disableBeforeUse() first to never create them.
+// Zones built on the render thread preload their sounds while the simulation thread
+// plays others, so the public calls take a lock.
+class AudioManager {
+private:
+    static const int MAX_VOICES = 16;
+
+    struct Voice {
+        Sound sound;
+        int priority;
+        unsigned long long startedAt;  // Play counter value when the voice was started
+    };
+
+    map<string, SoundBuffer> bufferCache;
+    set<string> failedBuffers;         // Paths that failed to load, so we don't retry every play
+    unique_ptr<Voice[]> voices;        // Null until audio is first enabled
+    unsigned long long playCounter;
+    unique_ptr<Music> music;
+    string currentMusicPath;
+    bool enabled;
+    mutable recursive_mutex lock;
+
+    static inline bool startDisabled = false;
+
+    AudioManager() : playCounter(0), enabled(!startDisabled) {
+        if (enabled) {
+            createVoices();
+        }
+    }
+
+    void createVoices() {
+        voices.reset(new Voice[MAX_VOICES]);
+        for (int i = 0; i < MAX_VOICES; i++) {
+            voices[i].priority = SOUND_PRIORITY_LOW;
+            voices[i].startedAt = 0;
+        }
+        music.reset(new Music());
+    }
+
+    AudioManager(const AudioManager&) = delete;
+    AudioManager& operator=(const AudioManager&) = delete;
+
+    // Pick a voice for a new sound: a free one first, otherwise steal the oldest
+    // voice with the lowest priority. Returns -1 if every voice outranks the new sound.
+    int findVoice(int priority) {
+        int candidate = -1;
+        for (int i = 0; i < MAX_VOICES; i++) {
+            if (voices[i].sound.getStatus() != Sound::Playing) {
+                return i;
+            }
+            if (candidate < 0 ||
+                voices[i].priority < voices[candidate].priority ||
+                (voices[i].priority == voices[candidate].priority && voices[i].startedAt < voices[candidate].startedAt)) {
+                candidate = i;
+            }
+        }
+        if (candidate >= 0 && voices[candidate].priority > priority) {
+            return -1;
+        }
+        return candidate;
+    }
+
+public:
+    ~AudioManager() {
+        // Voices must let go of their buffers before the cache is destroyed
+        if (!voices) return;
+        for (int i = 0; i < MAX_VOICES; i++) {
+            voices[i].sound.stop();
+            voices[i].sound.resetBuffer();
+        }
+        music->stop();
+    }
+
+    static AudioManager& getInstance() {
+        static AudioManager instance;
+        return instance;
+    }
+
+    // Start with audio disabled, so the audio device is never opened. Only has an
+    // effect before the first getInstance() (headless runs, benchmarks, replays).
+    static void disableBeforeUse() { startDisabled = true; }
+
+    // Get a decoded sound buffer, loading it on first use
+    const SoundBuffer* getBuffer(const string& filename) {
+        lock_guard<recursive_mutex> guard(lock);
+        map<string, SoundBuffer>::iterator it = bufferCache.find(filename);
+        if (it != bufferCache.end()) {
+            return &it->second;
+        }
+        if (failedBuffers.count(filename)) {
+            return nullptr;
+        }
+        TRACE_SCOPE_DETAIL("load", "sound", filename.c_str());
+        SoundBuffer& buffer = bufferCache[filename];
+        if (!buffer.loadFromFile(filename)) {
+            cout << "Failed to load sound: " << filename << endl;
+            bufferCache.erase(filename);
+            failedBuffers.insert(filename);
+            return nullptr;
+        }
+        return &buffer;
+    }
+
+    // Decode a sound ahead of time so the first play doesn't hit the disk
+    void preloadSound(const string& filename) {
+        lock_guard<recursive_mutex> guard(lock);
+        if (enabled) {
+            getBuffer(filename);
+        }
+    }
+
+    // Play a sound effect on a pooled voice
+    bool playSound(const string& filename, float volume = 100.0f, int priority = SOUND_PRIORITY_NORMAL) {
+        lock_guard<recursive_mutex> guard(lock);
+        if (!enabled) return false;
+
+        const SoundBuffer* buffer = getBuffer(filename);
+        if (!buffer) return false;
+
+        int index = findVoice(priority);
+        if (index < 0) return false;
+
+        Voice& voice = voices[index];
+        voice.sound.stop();
+        voice.sound.setBuffer(*buffer);
+        voice.sound.setVolume(volume);
+        voice.priority = priority;
+        voice.startedAt = ++playCounter;
+        voice.sound.play();
+        return true;
+    }
+
+    // Stream background music; re-requesting the track that is already playing is a no-op
+    bool playMusic(const string& filename, bool loop = true, float volume = 100.0f) {
+        lock_guard<recursive_mutex> guard(lock);
+        if (!enabled) return false;
+
+        if (filename == currentMusicPath && music->getStatus() == Music::Playing) {
+            return true;
+        }
+        TRACE_SCOPE_DETAIL("load", "music", filename.c_str());
+        music->stop();
+        if (!music->openFromFile(filename)) {
+            cout << "Failed to open music: " << filename << endl;
+            currentMusicPath.clear();
+            return false;
+        }
+        currentMusicPath = filename;
+        music->setLoop(loop);
+        music->setVolume(volume);
+        music->play();
+        return true;
+    }
+
+    void stopMusic() {
+        lock_guard<recursive_mutex> guard(lock);
+        if (music) music->stop();
+        currentMusicPath.clear();
+    }
+
+    void stopAllSounds() {
+        lock_guard<recursive_mutex> guard(lock);
+        if (!voices) return;
+        for (int i = 0; i < MAX_VOICES; i++) {
+            voices[i].sound.stop();
+        }
+    }
+
+    // Disable all audio output (e.g. when no audio device is wanted)
+    void setEnabled(bool value) {
+        lock_guard<recursive_mutex> guard(lock);
+        enabled = value;
+        if (enabled && !voices) {
+            createVoices();
+        }
+        if (!enabled) {
+            stopAllSounds();
+            stopMusic();
+        }
+    }
+    bool isEnabled() const { return enabled; }
+
+    int getActiveVoiceCount() const {
+        lock_guard<recursive_mutex> guard(lock);
+        int count = 0;
+        if (!voices) return 0;
+        for (int i = 0; i < MAX_VOICES; i++) {
+            if (voices[i].sound.getStatus() == Sound::Playing) count++;
+        }
+        return count;
+    }
+    int getCachedBufferCount() const {
+        lock_guard<recursive_mutex> guard(lock);
+        return static_cast<int>(bufferCache.size());
+    }
+    static int getMaxVoices() { return MAX_VOICES; }
+};
+
+#endif // AUDIO_MANAGER_H
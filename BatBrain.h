@@ -3,43 +3,49 @@
 
 #include "Enemy.h"
 
-class BatBrain : public Enemy {
-    static const float TRACK_SPEED;
-    static const float SIZE;
+// Flies straight at the player
+class BatBrainStore : public EnemyStore {
+    static constexpr float TRACK_SPEED = 80.0f;
+    static constexpr float SIZE = 64.0f;
 
 public:
-    BatBrain(float startX, float startY) {
-        if (!loadTexture("Data/batbrain.png")) return;
-        sprite.setTexture(texture);
-        sprite.setScale(2.0, 2.0);
-        posX = startX;
-        posY = startY;
-        health = 3;
-        speed = TRACK_SPEED;
-        width = SIZE;
-        height = SIZE;
+    BatBrainStore() : EnemyStore(SIZE, SIZE) {}
+
+    void loadTextures() {
+        loadTexture("Data/batbrain.png", 2.0f);
     }
 
-    void update(float deltaTime, float playerX, float playerY) override {
-        if (!isAlive) return;
+    void add(float startX, float startY) {
+        addEnemy(startX, startY, 3);
+    }
 
-        float centerX = posX + width / 2;
-        float centerY = posY + height / 2;
-        float dx = playerX - centerX;
-        float dy = playerY - centerY;
-        float distance = sqrt(dx * dx + dy * dy);
+    void clear() {
+        clearCommon();
+    }
 
-        if (distance > 10.0f) {
-            posX += (dx / distance) * speed * deltaTime;
-            posY += (dy / distance) * speed * deltaTime;
+    void update(float deltaTime, float playerX, float playerY) {
+        const int count = size();
+        for (int i = 0; i < count; i++) {
+            if (!alive[i]) continue;
+
+            float centerX = posX[i] + width / 2;
+            float centerY = posY[i] + height / 2;
+            float dx = playerX - centerX;
+            float dy = playerY - centerY;
+            float distance = sqrt(dx * dx + dy * dy);
+
+            if (distance > 10.0f) {
+                posX[i] += (dx / distance) * TRACK_SPEED * deltaTime;
+                posY[i] += (dy / distance) * TRACK_SPEED * deltaTime;
+            }
         }
     }
 
-    void draw(RenderWindow& window, float camera_offset_x) override {
-        Enemy::draw(window, camera_offset_x);
+    bool removeSpawnedOutside(float minX, float maxX) {
+        if (!selectSpawnedInside(minX, maxX)) return false;
+        compactCommon();
+        return true;
     }
 };
-const float BatBrain::TRACK_SPEED = 80.0f;
-const float BatBrain::SIZE = 64.0f;
 
-#endif // BATBRAIN_H 
\ No newline at end of file
+#endif // BATBRAIN_H
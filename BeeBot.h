@@ -3,120 +3,79 @@
 
 #include "Enemy.h"
 
-struct Projectile {
-    float x, y;
-    float velX, velY;
-    bool active;
-    static const float SIZE;
-};
-const float Projectile::SIZE = 8.0f;
+// Hovers in a figure-of-eight and fires slow shots at the player
+class BeeBotStore : public EnemyStore {
+    static constexpr float FIRE_RATE = 1.5f;
+    static constexpr float PROJECTILE_SPEED = 150.0f;
+    static constexpr float SIZE = 48.0f;
 
-class BeeBot : public Enemy {
-    static const float FIRE_RATE;
-    static const float PROJECTILE_SPEED;
-    static const int MAX_PROJECTILES;
-    static const float SIZE;
+public:
+    static const int MAX_SHOTS = 2;     // Alive at once per BeeBot
+    static constexpr float SHOT_SIZE = 8.0f;
 
-    Clock fireClock;
-    float patternOffset;
-    Projectile projectiles[2];  // Match MAX_PROJECTILES
-    Texture projectileTex;
-    Sprite projectileSprite;
+    // Per enemy
+    vector<float> fireTimer;      // Seconds since the last shot
+    vector<float> patternOffset;
 
-public:
-    BeeBot(float startX, float startY) : Enemy() {
-        if (!texture.loadFromFile("Data/beebot.png")) return;
-        sprite.setTexture(texture);
-        sprite.setScale(1.0f, 1.0f);
+    BeeBotStore() : EnemyStore(SIZE, SIZE) {}
 
-        posX = startX;
-        posY = startY;
-        health = 5;
-        speed = 150.0f;
-        width = SIZE;
-        height = SIZE;
-        patternOffset = 0.0f;
+    void loadTextures() {
+        loadTexture("Data/beebot.png", 1.0f);
+    }
 
-        // Projectile graphic setup
-        projectileTex.loadFromFile("Data/red_pixel.png");
-        projectileSprite.setTexture(projectileTex);
-        projectileSprite.setScale(Projectile::SIZE, Projectile::SIZE);
-        projectileSprite.setColor(Color::Red);
+    void add(float startX, float startY) {
+        addEnemy(startX, startY, 5);
+        fireTimer.push_back(0.0f);
+        patternOffset.push_back(0.0f);
+    }
 
-        for (int i = 0; i < 2; i++) {
-            projectiles[i].active = false;
-        }
+    void clear() {
+        clearCommon();
+        fireTimer.clear();
+        patternOffset.clear();
     }
 
-    void update(float deltaTime, float playerX, float playerY) override {
-        if (!isAlive) return;
+    // Move every BeeBot and fire into the level's projectile pool
+    void update(float deltaTime, float playerX, float playerY, ProjectilePool& projectiles, int ownerType) {
+        const int count = size();
 
         // Sinusoidal movement pattern
-        patternOffset += deltaTime;
-        posY += sin(patternOffset * 3.0f) * 50.0f * deltaTime;
-        posX += cos(patternOffset * 1.5f) * 25.0f * deltaTime;
+        for (int i = 0; i < count; i++) {
+            if (!alive[i]) continue;
+            patternOffset[i] += deltaTime;
+            posY[i] += sin(patternOffset[i] * 3.0f) * 50.0f * deltaTime;
+            posX[i] += cos(patternOffset[i] * 1.5f) * 25.0f * deltaTime;
+        }
 
         // Firing logic
-        if (fireClock.getElapsedTime().asSeconds() >= FIRE_RATE) {
-            fireClock.restart();
-
-            float centerX = posX + width / 2;
-            float centerY = posY + height / 2;
+        for (int i = 0; i < count; i++) {
+            if (!alive[i]) continue;
+            fireTimer[i] += deltaTime;
+            if (fireTimer[i] < FIRE_RATE) continue;
+            fireTimer[i] = 0.0f;
+            if (shotsLive[i] >= MAX_SHOTS) continue;
+
+            float centerX = posX[i] + width / 2;
+            float centerY = posY[i] + height / 2;
             float dx = playerX - centerX;
             float dy = playerY - centerY;
             float length = sqrt(dx * dx + dy * dy);
+            if (length <= 0) continue;
 
-            if (length > 0) {
-                for (int i = 0; i < 2; i++) {
-                    if (!projectiles[i].active) {
-                        projectiles[i].x = centerX - Projectile::SIZE / 2;
-                        projectiles[i].y = centerY - Projectile::SIZE / 2;
-                        projectiles[i].velX = (dx / length) * PROJECTILE_SPEED;
-                        projectiles[i].velY = (dy / length) * PROJECTILE_SPEED;
-                        projectiles[i].active = true;
-                        break;
-                    }
-                }
-            }
-        }
-
-        // Update projectiles
-        for (int i = 0; i < 2; i++) {
-            if (projectiles[i].active) {
-                projectiles[i].x += projectiles[i].velX * deltaTime;
-                projectiles[i].y += projectiles[i].velY * deltaTime;
-
-                // Deactivate projectiles outside view
-                if (projectiles[i].x < -100 || projectiles[i].x > 1300 ||
-                    projectiles[i].y < -100 || projectiles[i].y > 1000) {
-                    projectiles[i].active = false;
-                }
+            if (projectiles.spawn(PROJECTILE_BEEBOT, centerX - SHOT_SIZE / 2, centerY - SHOT_SIZE / 2,
+                    (dx / length) * PROJECTILE_SPEED, (dy / length) * PROJECTILE_SPEED, ownerType, i) >= 0) {
+                shotsLive[i]++;
             }
         }
     }
 
-    void draw(RenderWindow& window, float camera_offset_x) override {
-        Enemy::draw(window, camera_offset_x);
-
-        // Draw active projectiles
-        for (int i = 0; i < 2; i++) {
-            if (projectiles[i].active) {
-                projectileSprite.setPosition(
-                    projectiles[i].x - camera_offset_x,
-                    projectiles[i].y
-                );
-                window.draw(projectileSprite);
-            }
-        }
+    bool removeSpawnedOutside(float minX, float maxX) {
+        if (!selectSpawnedInside(minX, maxX)) return false;
+        compactCommon();
+        compact(fireTimer);
+        compact(patternOffset);
+        return true;
     }
-
-    static int getMaxProjectiles() { return 2; }
-    const Projectile& getProjectile(int idx) const { return projectiles[idx]; }
 };
 
-const float BeeBot::FIRE_RATE = 1.5f;
-const float BeeBot::PROJECTILE_SPEED = 150.0f;
-const int BeeBot::MAX_PROJECTILES = 2;
-const float BeeBot::SIZE = 48.0f;
-
-#endif // BEEBOT_H
\ No newline at end of file
+#endif // BEEBOT_H
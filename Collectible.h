@@ -3,6 +3,10 @@
 
 #include <SFML/Graphics.hpp>
 #include <string>
+#include "TextureCache.h"
+#include "CollisionBatch.h"
+#include "RenderSnapshot.h"
+#include "SpriteBatch.h"
 
 using namespace sf;
 using namespace std;
@@ -13,18 +17,19 @@ protected:
     float scale;
     bool isCollected;
     bool isVisible;
-    Texture texture;
+    TextureRegion texture;
     Sprite sprite;
     int width, height;
     int hitBoxFactorX, hitBoxFactorY;
 
     // Non-virtual helper functions
     bool loadTexture(const string& filename) {
-        if (!texture.loadFromFile(filename)) {
+        if (!TextureCache::getInstance().acquireRegion(filename, texture)) {
             cout << "Failed to load collectible texture: " << filename << endl;
             return false;
         }
-        sprite.setTexture(texture);
+        sprite.setTexture(*texture.texture);
+        sprite.setTextureRect(texture.rect);
         return true;
     }
 
@@ -68,7 +73,8 @@ public:
 
     // Virtual functions that must be implemented by derived classes
     virtual void update(float deltaTime) = 0;
-    virtual void draw(RenderWindow& window, float camera_offset_x) = 0;
+    virtual void draw(SpriteBatch& batch, float camera_offset_x) const = 0;
+    virtual void capture(RenderSnapshot& snapshot) const = 0;   // draw(), into a snapshot
     virtual void onCollect() = 0;
     virtual bool checkCollision(float playerX, float playerY, int playerWidth, int playerHeight) = 0;
     virtual string getType() const = 0;
@@ -0,0 +1,216 @@
+#ifndef COLLISION_BATCH_H
+#define COLLISION_BATCH_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define COLLISION_BATCH_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC / Clang compile the AVX2 kernel for AVX2 without requiring it of the whole
+// program; it only runs after the CPU check. MSVC allows the intrinsics anywhere.
+#if defined(COLLISION_BATCH_X86) && (defined(__GNUC__) || defined(__clang__))
+#define COLLISION_BATCH_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define COLLISION_BATCH_AVX2_TARGET
+#endif
+
+using namespace std;
+
+// The one AABB test every collision check in the game uses: true if box 1
+// overlaps box 2 (touching edges don't count)
+inline bool boxesOverlap(float x1, float y1, float w1, float h1,
+    float x2, float y2, float w2, float h2) {
+    return x1 < x2 + w2 &&
+        x1 + w1 > x2 &&
+        y1 < y2 + h2 &&
+        y1 + h1 > y2;
+}
+
+// Candidate boxes as parallel arrays, the input of CollisionBatch::test
+struct BoxArrays {
+    vector<float> x, y, w, h;
+
+    void clear() {
+        x.clear(); y.clear();
+        w.clear(); h.clear();
+    }
+
+    void push(float boxX, float boxY, float boxW, float boxH) {
+        x.push_back(boxX); y.push_back(boxY);
+        w.push_back(boxW); h.push_back(boxH);
+    }
+
+    int size() const { return static_cast<int>(x.size()); }
+};
+
+enum CollisionPath {
+    COLLISION_SCALAR = 0,
+    COLLISION_SSE,      // 4 boxes per step
+    COLLISION_AVX2,     // 8 boxes per step
+    COLLISION_PATH_COUNT
+};
+
+// Tests one box (the player) against many at once. Bit i of the result mask is set
+// if candidate i overlaps, so callers only touch the hits. The SIMD kernels give
+// exactly the same answers as boxesOverlap; the fastest one the CPU supports is
+// picked on first use.
+class CollisionBatch {
+private:
+    static void testScalar(float px, float py, float pw, float ph,
+        const float* x, const float* y, const float* w, const float* h,
+        int first, int count, uint64_t* hits) {
+        for (int i = first; i < count; i++) {
+            if (boxesOverlap(px, py, pw, ph, x[i], y[i], w[i], h[i])) {
+                hits[i >> 6] |= uint64_t(1) << (i & 63);
+            }
+        }
+    }
+
+#ifdef COLLISION_BATCH_X86
+    static void testSSE(float px, float py, float pw, float ph,
+        const float* x, const float* y, const float* w, const float* h,
+        int count, uint64_t* hits) {
+        const __m128 left = _mm_set1_ps(px);
+        const __m128 right = _mm_set1_ps(px + pw);
+        const __m128 top = _mm_set1_ps(py);
+        const __m128 bottom = _mm_set1_ps(py + ph);
+        int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128 bx = _mm_loadu_ps(x + i);
+            __m128 by = _mm_loadu_ps(y + i);
+            __m128 overlap = _mm_and_ps(
+                _mm_and_ps(_mm_cmplt_ps(left, _mm_add_ps(bx, _mm_loadu_ps(w + i))), _mm_cmpgt_ps(right, bx)),
+                _mm_and_ps(_mm_cmplt_ps(top, _mm_add_ps(by, _mm_loadu_ps(h + i))), _mm_cmpgt_ps(bottom, by)));
+            uint64_t bits = static_cast<uint64_t>(_mm_movemask_ps(overlap));
+            hits[i >> 6] |= bits << (i & 63);
+        }
+        testScalar(px, py, pw, ph, x, y, w, h, i, count, hits);
+    }
+
+    COLLISION_BATCH_AVX2_TARGET
+    static void testAVX2(float px, float py, float pw, float ph,
+        const float* x, const float* y, const float* w, const float* h,
+        int count, uint64_t* hits) {
+        const __m256 left = _mm256_set1_ps(px);
+        const __m256 right = _mm256_set1_ps(px + pw);
+        const __m256 top = _mm256_set1_ps(py);
+        const __m256 bottom = _mm256_set1_ps(py + ph);
+        int i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256 bx = _mm256_loadu_ps(x + i);
+            __m256 by = _mm256_loadu_ps(y + i);
+            __m256 overlap = _mm256_and_ps(
+                _mm256_and_ps(_mm256_cmp_ps(left, _mm256_add_ps(bx, _mm256_loadu_ps(w + i)), _CMP_LT_OQ),
+                    _mm256_cmp_ps(right, bx, _CMP_GT_OQ)),
+                _mm256_and_ps(_mm256_cmp_ps(top, _mm256_add_ps(by, _mm256_loadu_ps(h + i)), _CMP_LT_OQ),
+                    _mm256_cmp_ps(bottom, by, _CMP_GT_OQ)));
+            uint64_t bits = static_cast<uint64_t>(_mm256_movemask_ps(overlap));
+            hits[i >> 6] |= bits << (i & 63);
+        }
+        testScalar(px, py, pw, ph, x, y, w, h, i, count, hits);
+    }
+
+    static bool cpuHasAVX2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        bool osSavesYmm = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+        __cpuidex(info, 7, 0);
+        return osSavesYmm && (info[1] & (1 << 5));
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+
+    static CollisionPath& activePath() {
+        static CollisionPath path = defaultPath();
+        return path;
+    }
+
+    // Best supported path; SONIC_COLLISION_PATH=scalar|sse|avx2 can ask for a slower one
+    static CollisionPath defaultPath() {
+        CollisionPath best = isSupported(COLLISION_AVX2) ? COLLISION_AVX2
+            : isSupported(COLLISION_SSE) ? COLLISION_SSE : COLLISION_SCALAR;
+        const char* requested = getenv("SONIC_COLLISION_PATH");
+        if (requested) {
+            for (int p = 0; p < best; p++) {
+                if (strcmp(requested, getPathName(static_cast<CollisionPath>(p))) == 0) {
+                    return static_cast<CollisionPath>(p);
+                }
+            }
+        }
+        return best;
+    }
+
+public:
+    static bool isSupported(CollisionPath path) {
+        switch (path) {
+            case COLLISION_SCALAR: return true;
+#ifdef COLLISION_BATCH_X86
+            case COLLISION_SSE: return true;     // Every x86 target the game builds for has SSE2
+            case COLLISION_AVX2: return cpuHasAVX2();
+#endif
+            default: return false;
+        }
+    }
+
+    static CollisionPath getPath() { return activePath(); }
+
+    // Force a kernel (benchmarks); false if the CPU can't run it
+    static bool setPath(CollisionPath path) {
+        if (!isSupported(path)) return false;
+        activePath() = path;
+        return true;
+    }
+
+    static const char* getPathName(CollisionPath path) {
+        static const char* const names[COLLISION_PATH_COUNT] = { "scalar", "sse", "avx2" };
+        return (path >= 0 && path < COLLISION_PATH_COUNT) ? names[path] : "?";
+    }
+
+    // Words of mask needed for count candidates
+    static int maskWords(int count) { return (count + 63) / 64; }
+
+    // Test box (px, py, pw, ph) against candidates 0..count-1. hits must hold
+    // maskWords(count) words; they are overwritten. Returns the number of hits.
+    static int test(float px, float py, float pw, float ph,
+        const float* x, const float* y, const float* w, const float* h,
+        int count, uint64_t* hits) {
+        memset(hits, 0, sizeof(uint64_t) * maskWords(count));
+        switch (activePath()) {
+#ifdef COLLISION_BATCH_X86
+            case COLLISION_AVX2: testAVX2(px, py, pw, ph, x, y, w, h, count, hits); break;
+            case COLLISION_SSE: testSSE(px, py, pw, ph, x, y, w, h, count, hits); break;
+#endif
+            default: testScalar(px, py, pw, ph, x, y, w, h, 0, count, hits); break;
+        }
+        int total = 0;
+        for (int word = 0; word < maskWords(count); word++) {
+            for (uint64_t bits = hits[word]; bits; bits &= bits - 1) total++;
+        }
+        return total;
+    }
+
+    static int test(float px, float py, float pw, float ph, const BoxArrays& boxes, vector<uint64_t>& hits) {
+        hits.resize(maskWords(boxes.size()));
+        if (boxes.size() == 0) return 0;
+        return test(px, py, pw, ph, boxes.x.data(), boxes.y.data(), boxes.w.data(), boxes.h.data(), boxes.size(), hits.data());
+    }
+
+    static bool isHit(const vector<uint64_t>& hits, int i) {
+        return (hits[i >> 6] >> (i & 63)) & 1;
+    }
+};
+
+#endif // COLLISION_BATCH_H
@@ -3,121 +3,93 @@
 
 #include "Enemy.h"
 
-class CrabMeat : public Enemy {
-    static const float PATROL_SPEED;
-    static const float FIRE_RATE;
-    static const float PROJECTILE_SPEED;
-    static const float PATROL_RANGE;
-
-    Clock fireClock;
-    float originalX;
-    float patrolOffset;
-    bool movingRight;
-    Texture projTex;  // Simple texture for projectiles
+// Patrols back and forth and lobs fast shots at the player
+class CrabMeatStore : public EnemyStore {
+    static constexpr float PATROL_SPEED = 90.0f;
+    static constexpr float FIRE_RATE = 4.0f;
+    static constexpr float PROJECTILE_SPEED = 350.0f;
+    static constexpr float PATROL_RANGE = 270.0f;
 
 public:
-    struct Projectile {
-        float x, y;
-        float velX, velY;
-        bool active;
-    };
-    Projectile projectiles[4];
+    static const int MAX_SHOTS = 4;     // Alive at once per CrabMeat
 
-    CrabMeat(float startX, float startY) : Enemy() {
-        texture.loadFromFile("Data/Crab.png");
-        sprite.setTexture(texture);
+    // Per enemy
+    vector<float> fireTimer;      // Seconds since the last shot
+    vector<float> originalX;
+    vector<float> patrolOffset;
+    vector<unsigned char> movingRight;
 
-        // Create simple projectile texture (1x1 white pixel)
-        projTex.loadFromFile("Data/white_pixel.png");  // Ensure this file exists
-        posX = startX;
-        posY = startY;
-        health = 4;
-        speed = PATROL_SPEED;
-        width = 80.0f;
-        height = 56.0f;
-        movingRight = true;
-        originalX = startX;
+    CrabMeatStore() : EnemyStore(80.0f, 56.0f) {}
 
-        for (int i = 0; i < 4; i++) {
-            projectiles[i].active = false;
-        }
+    void loadTextures() {
+        loadTexture("Data/Crab.png", 1.0f);
     }
 
-    void update(float deltaTime, float playerX, float playerY) override {
-        if (!isAlive) return;
-
-        // Patrol logic (same as original)
-        float moveAmount = speed * deltaTime;
-        patrolOffset += movingRight ? moveAmount : -moveAmount;
-        if (patrolOffset > PATROL_RANGE) {
-            movingRight = false;
-            patrolOffset = PATROL_RANGE;
-        }
-        else if (patrolOffset < 0) {
-            movingRight = true;
-            patrolOffset = 0;
-        }
-        posX = originalX + patrolOffset;
+    void add(float startX, float startY) {
+        addEnemy(startX, startY, 4);
+        fireTimer.push_back(0.0f);
+        originalX.push_back(startX);
+        patrolOffset.push_back(0.0f);
+        movingRight.push_back(1);
+    }
 
-        // Shooting logic (same as original)
-        if (fireClock.getElapsedTime().asSeconds() >= FIRE_RATE) {
-            fireClock.restart();
-            float dx = playerX - posX;
-            float dy = playerY - posY;
-            float length = sqrt(dx * dx + dy * dy);
+    void clear() {
+        clearCommon();
+        fireTimer.clear();
+        originalX.clear();
+        patrolOffset.clear();
+        movingRight.clear();
+    }
 
-            if (length > 0) {
-                for (int i = 0; i < 4; i++) {
-                    if (!projectiles[i].active) {
-                        projectiles[i].x = posX + width / 2;
-                        projectiles[i].y = posY + height / 2;
-                        projectiles[i].velX = (dx / length) * PROJECTILE_SPEED;
-                        projectiles[i].velY = (dy / length) * PROJECTILE_SPEED;
-                        projectiles[i].active = true;
-                        break;
-                    }
-                }
+    // Move every CrabMeat and fire into the level's projectile pool
+    void update(float deltaTime, float playerX, float playerY, ProjectilePool& projectiles, int ownerType) {
+        const int count = size();
+
+        // Patrol logic
+        const float moveAmount = PATROL_SPEED * deltaTime;
+        for (int i = 0; i < count; i++) {
+            if (!alive[i]) continue;
+            patrolOffset[i] += movingRight[i] ? moveAmount : -moveAmount;
+            if (patrolOffset[i] > PATROL_RANGE) {
+                movingRight[i] = 0;
+                patrolOffset[i] = PATROL_RANGE;
             }
-        }
-
-        // Projectile movement (same as original)
-        for (int i = 0; i < 4; i++) {
-            if (projectiles[i].active) {
-                projectiles[i].x += projectiles[i].velX * deltaTime;
-                projectiles[i].y += projectiles[i].velY * deltaTime;
-                if (projectiles[i].x > posX + 1000.0f) {
-                    projectiles[i].active = false;
-                }
+            else if (patrolOffset[i] < 0) {
+                movingRight[i] = 1;
+                patrolOffset[i] = 0;
             }
+            posX[i] = originalX[i] + patrolOffset[i];
         }
-    }
 
-    void draw(RenderWindow& window, float camera_offset_x) override {
-        Enemy::draw(window, camera_offset_x);
+        // Shooting logic
+        for (int i = 0; i < count; i++) {
+            if (!alive[i]) continue;
+            fireTimer[i] += deltaTime;
+            if (fireTimer[i] < FIRE_RATE) continue;
+            fireTimer[i] = 0.0f;
+            if (shotsLive[i] >= MAX_SHOTS) continue;
 
-        // Draw projectiles as simple rectangles using the texture
-        Sprite projSprite(projTex);
-        projSprite.setColor(Color::Yellow);
-        projSprite.setScale(10, 6);  // 10x6 pixels
+            float dx = playerX - posX[i];
+            float dy = playerY - posY[i];
+            float length = sqrt(dx * dx + dy * dy);
+            if (length <= 0) continue;
 
-        for (int i = 0; i < 4; i++) {
-            if (projectiles[i].active) {
-                projSprite.setPosition(
-                    projectiles[i].x - camera_offset_x,
-                    projectiles[i].y
-                );
-                window.draw(projSprite);
+            if (projectiles.spawn(PROJECTILE_CRABMEAT, posX[i] + width / 2, posY[i] + height / 2,
+                    (dx / length) * PROJECTILE_SPEED, (dy / length) * PROJECTILE_SPEED, ownerType, i) >= 0) {
+                shotsLive[i]++;
             }
         }
     }
 
-    const Projectile& getProjectile(int idx) const { return projectiles[idx]; }
-    void setProjectileActive(int idx, bool active) { projectiles[idx].active = active; }
+    bool removeSpawnedOutside(float minX, float maxX) {
+        if (!selectSpawnedInside(minX, maxX)) return false;
+        compactCommon();
+        compact(fireTimer);
+        compact(originalX);
+        compact(patrolOffset);
+        compact(movingRight);
+        return true;
+    }
 };
 
-const float CrabMeat::PATROL_SPEED = 90.0f;
-const float CrabMeat::FIRE_RATE = 4.0f;
-const float CrabMeat::PROJECTILE_SPEED = 350.0f;
-const float CrabMeat::PATROL_RANGE = 270.0f;
-
-#endif // CRABMEAT_H
\ No newline at end of file
+#endif // CRABMEAT_H
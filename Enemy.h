@@ -3,54 +3,132 @@
 
 #include <SFML/Graphics.hpp>
 #include <cmath>
+#include <vector>
+#include "TextureCache.h"
+#include "FixedTimestep.h"
+#include "ProjectilePool.h"
+#include "CollisionBatch.h"
+#include "SpriteBatch.h"
 
 using namespace sf;
 using namespace std;
 
 // Collision helper function
-bool checkCollision(float x1, float y1, float w1, float h1,
+inline bool checkCollision(float x1, float y1, float w1, float h1,
     float x2, float y2, float w2, float h2) {
-    return x1 < x2 + w2 &&
-        x1 + w1 > x2 &&
-        y1 < y2 + h2 &&
-        y1 + h1 > y2;
+    return boxesOverlap(x1, y1, w1, h1, x2, y2, w2, h2);
 }
 
-// Base Enemy Class
-class Enemy {
+// Enemies are kept per type as a structure of arrays: one array per field, index i
+// across all of them is one enemy. Each type's update is a plain loop over its own
+// arrays - no per-enemy allocation, no virtual calls. EnemyStore holds the fields
+// every type has; the type headers (BatBrain.h, ...) add their own and the kernel.
+class EnemyStore {
+public:
+    vector<float> posX, posY;
+    vector<float> prevX, prevY;   // Position at the start of the current tick, for render interpolation
+    vector<float> spawnX;         // Where the enemy was placed (it may have wandered since)
+    vector<int> health;
+    vector<unsigned char> alive;
+    vector<unsigned char> shotsLive;   // Shots of this enemy still in the ProjectilePool
+
 protected:
+    float width, height;          // Same for every enemy of a type
+    TextureRegion texture;
     Sprite sprite;
-    Texture texture;
-    float posX, posY;
-    float width, height;
-    int health;
-    float speed;
-    bool isAlive;
+    vector<int> keep;             // Scratch for compaction
+    vector<int> remap;            // After compaction: old index -> new index, -1 if removed
+
+    EnemyStore(float w, float h) : width(w), height(h) {}
 
-    bool loadTexture(const string& path) {
-        return texture.loadFromFile(path);
+    bool loadTexture(const string& path, float scale) {
+        bool loaded = TextureCache::getInstance().acquireRegion(path, texture);
+        sprite.setTexture(*texture.texture);
+        sprite.setTextureRect(texture.rect);
+        sprite.setScale(scale, scale);
+        return loaded;
     }
 
-public:
-    Enemy() : isAlive(true) {}
-    virtual ~Enemy() = default;
-
-    virtual void update(float deltaTime, float playerX, float playerY) = 0;
-    virtual void draw(RenderWindow& window, float camera_offset_x) {
-        if (isAlive) {
-            sprite.setPosition(posX - camera_offset_x, posY);
-            window.draw(sprite);
+    // Append the common fields of a new enemy and return its index
+    int addEnemy(float x, float y, int hp) {
+        posX.push_back(x);
+        posY.push_back(y);
+        prevX.push_back(x);   // Start with no motion to interpolate from
+        prevY.push_back(y);
+        spawnX.push_back(x);
+        health.push_back(hp);
+        alive.push_back(1);
+        shotsLive.push_back(0);
+        return static_cast<int>(posX.size()) - 1;
+    }
+
+    void clearCommon() {
+        posX.clear(); posY.clear();
+        prevX.clear(); prevY.clear();
+        spawnX.clear();
+        health.clear();
+        alive.clear();
+        shotsLive.clear();
+    }
+
+    // Fill 'keep' (and 'remap') with the indices of enemies spawned inside [minX, maxX).
+    // Returns false if every enemy stays.
+    bool selectSpawnedInside(float minX, float maxX) {
+        keep.clear();
+        remap.assign(spawnX.size(), -1);
+        for (size_t i = 0; i < spawnX.size(); i++) {
+            if (spawnX[i] >= minX && spawnX[i] < maxX) {
+                remap[i] = static_cast<int>(keep.size());
+                keep.push_back(static_cast<int>(i));
+            }
+        }
+        return keep.size() != spawnX.size();
+    }
+
+    // Keep only the 'keep' entries of a column (stride values per enemy)
+    template <typename T>
+    void compact(vector<T>& column, int stride = 1) const {
+        for (size_t k = 0; k < keep.size(); k++) {
+            for (int s = 0; s < stride; s++) {
+                column[k * stride + s] = column[keep[k] * stride + s];
+            }
         }
+        column.resize(keep.size() * stride);
+    }
+
+    void compactCommon() {
+        compact(posX); compact(posY);
+        compact(prevX); compact(prevY);
+        compact(spawnX);
+        compact(health);
+        compact(alive);
+        compact(shotsLive);
+    }
+
+public:
+    int size() const { return static_cast<int>(posX.size()); }
+    const vector<int>& getRemap() const { return remap; }
+    float getWidth() const { return width; }
+    float getHeight() const { return height; }
+
+    void storePreviousPositions() {
+        prevX.assign(posX.begin(), posX.end());
+        prevY.assign(posY.begin(), posY.end());
     }
 
-    bool getIsAlive() const { return isAlive; }
-    void getPosition(float& x, float& y) const { x = posX; y = posY; }
-    void getSize(float& w, float& h) const { w = width; h = height; }
+    void takeDamage(int i, int damage) {
+        health[i] -= damage;
+        if (health[i] <= 0) alive[i] = 0;
+    }
+
+    // One enemy; EnemyManager picks which ones are on screen
+    void drawBody(SpriteBatch& batch, int i, float camera_offset_x, float alpha) const {
+        batch.submit(sprite, interpolate(prevX[i], posX[i], alpha) - camera_offset_x, interpolate(prevY[i], posY[i], alpha), LAYER_ENEMIES);
+    }
 
-    void takeDamage(int damage) {
-        health -= damage;
-        if (health <= 0) isAlive = false;
+    void captureBody(RenderSnapshot& snapshot, int i) const {
+        snapshot.addSprite(sprite, prevX[i], prevY[i], posX[i], posY[i], LAYER_ENEMIES);
     }
 };
 
-#endif // ENEMY_H 
\ No newline at end of file
+#endif // ENEMY_H
@@ -1,73 +1,285 @@
 #ifndef ENEMY_MANAGER_H
 #define ENEMY_MANAGER_H
 
+#include <algorithm>
 #include "Enemy.h"
 #include "BatBrain.h"
 #include "BeeBot.h"
 #include "Motobug.h"
 #include "CrabMeat.h"
+#include "SpatialHash.h"
 
+enum EnemyType {
+    ENEMY_BATBRAIN = 0,
+    ENEMY_BEEBOT,
+    ENEMY_MOTOBUG,
+    ENEMY_CRABMEAT,
+    ENEMY_TYPE_COUNT
+};
+
+// Owns every enemy of a level, one structure-of-arrays store per type (see Enemy.h).
+// Updates run type by type over contiguous arrays; the store types are known here at
+// compile time, so nothing in the per-tick loops is virtual.
 class EnemyManager {
 private:
-    static const int MAX_ENEMIES = 64;
-    Enemy* enemies[MAX_ENEMIES];
-    int enemyCount;
+    BatBrainStore batBrains;
+    BeeBotStore beeBots;
+    MotobugStore motobugs;
+    CrabMeatStore crabMeats;
+    bool texturesLoaded;
 
-public:
-    EnemyManager() : enemyCount(0) {
-        for (int i = 0; i < MAX_ENEMIES; ++i) enemies[i] = nullptr;
+    // Every shot fired by any enemy type
+    ProjectilePool projectiles;
+
+    // Broad phase ids: enemies by index * ENEMY_TYPE_COUNT + type, projectiles by pool slot
+    SpatialHash enemyGrid;
+    SpatialHash projectileGrid;
+    vector<int> nearby;
+    vector<int> visible;          // Scratch for camera-window queries
+    int culled;                   // Living enemies the last draw / capture skipped
+    float worldHeight;
+    BoxArrays candidates;         // Boxes of the grid query results, for CollisionBatch
+    vector<uint64_t> hits;
+
+    static int enemyId(int type, int i) { return i * ENEMY_TYPE_COUNT + type; }
+
+    // Re-bucket an enemy after it moved (or died)
+    template <typename Store>
+    void updateSpatial(int type, const Store& store, int i) {
+        int id = enemyId(type, i);
+        if (!store.alive[i]) {
+            enemyGrid.remove(id);
+            return;
+        }
+        enemyGrid.update(id, store.posX[i], store.posY[i], store.getWidth(), store.getHeight());
     }
-    ~EnemyManager() {
-        clear();
+
+    template <typename Store>
+    void updateSpatialAll(int type, const Store& store) {
+        for (int i = 0; i < store.size(); ++i) {
+            updateSpatial(type, store, i);
+        }
+    }
+
+    void rebuildSpatial() {
+        enemyGrid.clear();
+        projectileGrid.clear();
+        updateSpatialAll(ENEMY_BATBRAIN, batBrains);
+        updateSpatialAll(ENEMY_BEEBOT, beeBots);
+        updateSpatialAll(ENEMY_MOTOBUG, motobugs);
+        updateSpatialAll(ENEMY_CRABMEAT, crabMeats);
+        updateProjectileSpatial();
     }
 
+    void updateProjectileSpatial() {
+        FloatRect bounds;
+        for (int slot = 0; slot < projectiles.getUsedSlots(); ++slot) {
+            if (projectiles.getBounds(slot, bounds)) {
+                projectileGrid.update(slot, bounds.left, bounds.top, bounds.width, bounds.height);
+            }
+        }
+    }
+
+    // Shared textures are acquired with the first enemy, not per enemy
+    void ensureTextures() {
+        if (texturesLoaded) return;
+        batBrains.loadTextures();
+        beeBots.loadTextures();
+        motobugs.loadTextures();
+        crabMeats.loadTextures();
+        texturesLoaded = true;
+    }
+
+    EnemyStore& storeFor(int type) {
+        switch (type) {
+            case ENEMY_BATBRAIN: return batBrains;
+            case ENEMY_BEEBOT: return beeBots;
+            case ENEMY_MOTOBUG: return motobugs;
+            default: return crabMeats;
+        }
+    }
+
+    const EnemyStore& storeFor(int type) const {
+        return const_cast<EnemyManager*>(this)->storeFor(type);
+    }
+
+    // Fill 'visible' with the ids of the living enemies overlapping the columns
+    // [minX, maxX], grouped by type (so consecutive draws share a texture) and in
+    // index order within a type
+    void findVisible(float minX, float maxX) {
+        visible.clear();
+        enemyGrid.query(minX, 0, maxX - minX, worldHeight, visible);
+        size_t kept = 0;
+        for (size_t n = 0; n < visible.size(); n++) {
+            const EnemyStore& store = storeFor(visible[n] % ENEMY_TYPE_COUNT);
+            int i = visible[n] / ENEMY_TYPE_COUNT;
+            if (store.posX[i] + store.getWidth() >= minX && store.posX[i] <= maxX) {
+                visible[kept++] = visible[n];
+            }
+        }
+        visible.resize(kept);
+        sort(visible.begin(), visible.end(), [](int a, int b) {
+            int typeA = a % ENEMY_TYPE_COUNT, typeB = b % ENEMY_TYPE_COUNT;
+            return typeA != typeB ? typeA < typeB : a < b;
+        });
+        culled = enemyGrid.getItemCount() - static_cast<int>(kept);
+    }
+
+public:
+    EnemyManager() : texturesLoaded(false), culled(0), worldHeight(0) {}
+
     void clear() {
-        for (int i = 0; i < enemyCount; ++i) {
-            delete enemies[i];
-            enemies[i] = nullptr;
+        batBrains.clear();
+        beeBots.clear();
+        motobugs.clear();
+        crabMeats.clear();
+        projectiles.clear();
+        enemyGrid.clear();
+        projectileGrid.clear();
+    }
+
+    // Delete every enemy spawned outside [minX, maxX) - a streamed level drops enemies
+    // with the part of the level they came from. Survivors are re-indexed and their
+    // shots follow them; shots of removed enemies fly on without an owner.
+    void removeSpawnedOutside(float minX, float maxX) {
+        bool removed = batBrains.removeSpawnedOutside(minX, maxX);
+        if (beeBots.removeSpawnedOutside(minX, maxX)) {
+            projectiles.remapOwners(ENEMY_BEEBOT, beeBots.getRemap());
+            removed = true;
+        }
+        removed = motobugs.removeSpawnedOutside(minX, maxX) || removed;
+        if (crabMeats.removeSpawnedOutside(minX, maxX)) {
+            projectiles.remapOwners(ENEMY_CRABMEAT, crabMeats.getRemap());
+            removed = true;
         }
-        enemyCount = 0;
+        if (removed) {
+            rebuildSpatial();
+        }
+    }
+
+    // Size the collision grids to the level the enemies live in
+    void setWorldBounds(int columns, int rows, float cellSize) {
+        worldHeight = rows * cellSize;
+        enemyGrid.reset(columns, rows, cellSize);
+        projectileGrid.reset(columns, rows, cellSize);
+        rebuildSpatial();
     }
 
     bool addBatBrain(float x, float y) {
-        if (enemyCount >= MAX_ENEMIES) return false;
-        enemies[enemyCount++] = new BatBrain(x, y);
+        ensureTextures();
+        batBrains.add(x, y);
+        updateSpatial(ENEMY_BATBRAIN, batBrains, batBrains.size() - 1);
         return true;
     }
     bool addBeeBot(float x, float y) {
-        if (enemyCount >= MAX_ENEMIES) return false;
-        enemies[enemyCount++] = new BeeBot(x, y);
+        ensureTextures();
+        beeBots.add(x, y);
+        updateSpatial(ENEMY_BEEBOT, beeBots, beeBots.size() - 1);
         return true;
     }
     bool addMotobug(float x, float y) {
-        if (enemyCount >= MAX_ENEMIES) return false;
-        enemies[enemyCount++] = new Motobug(x, y);
+        ensureTextures();
+        motobugs.add(x, y);
+        updateSpatial(ENEMY_MOTOBUG, motobugs, motobugs.size() - 1);
         return true;
     }
     bool addCrabMeat(float x, float y) {
-        if (enemyCount >= MAX_ENEMIES) return false;
-        enemies[enemyCount++] = new CrabMeat(x, y);
+        ensureTextures();
+        crabMeats.add(x, y);
+        updateSpatial(ENEMY_CRABMEAT, crabMeats, crabMeats.size() - 1);
         return true;
     }
 
-    void updateAll(float deltaTime, float playerX, float playerY) {
-        for (int i = 0; i < enemyCount; ++i) {
-            if (enemies[i] && enemies[i]->getIsAlive()) {
-                enemies[i]->update(deltaTime, playerX, playerY);
+    // 'view' is the area the camera can see (plus a margin); shots leaving it are culled
+    void updateAll(float deltaTime, float playerX, float playerY, const FloatRect& view) {
+        projectiles.storePreviousPositions();
+
+        batBrains.storePreviousPositions();
+        batBrains.update(deltaTime, playerX, playerY);
+        updateSpatialAll(ENEMY_BATBRAIN, batBrains);
+
+        beeBots.storePreviousPositions();
+        beeBots.update(deltaTime, playerX, playerY, projectiles, ENEMY_BEEBOT);
+        updateSpatialAll(ENEMY_BEEBOT, beeBots);
+
+        motobugs.storePreviousPositions();
+        motobugs.update(deltaTime, playerX, playerY);
+        updateSpatialAll(ENEMY_MOTOBUG, motobugs);
+
+        crabMeats.storePreviousPositions();
+        crabMeats.update(deltaTime, playerX, playerY, projectiles, ENEMY_CRABMEAT);
+        updateSpatialAll(ENEMY_CRABMEAT, crabMeats);
+
+        // All shots move in one pass, then the ones out of view go back to the pool
+        projectiles.integrate(deltaTime);
+        projectiles.cull(view, [this](int slot) {
+            if (projectiles.ownerIndex[slot] >= 0) {
+                storeFor(projectiles.ownerType[slot]).shotsLive[projectiles.ownerIndex[slot]]--;
             }
+            projectileGrid.remove(slot);
+        });
+        updateProjectileSpatial();
+    }
+
+    // Draw the enemies between minX and maxX (world columns, margin included) and
+    // every shot - shots are already dropped once they leave the view (see updateAll)
+    void drawVisible(SpriteBatch& batch, float camera_offset_x, float minX, float maxX, float alpha = 1.0f) {
+        findVisible(minX, maxX);
+        for (size_t n = 0; n < visible.size(); n++) {
+            storeFor(visible[n] % ENEMY_TYPE_COUNT).drawBody(batch, visible[n] / ENEMY_TYPE_COUNT, camera_offset_x, alpha);
+        }
+        projectiles.draw(batch, camera_offset_x, alpha);
+    }
+
+    void captureVisible(RenderSnapshot& snapshot, float minX, float maxX) {
+        findVisible(minX, maxX);
+        for (size_t n = 0; n < visible.size(); n++) {
+            storeFor(visible[n] % ENEMY_TYPE_COUNT).captureBody(snapshot, visible[n] / ENEMY_TYPE_COUNT);
         }
+        projectiles.capture(snapshot);
     }
 
-    void drawAll(RenderWindow& window, float camera_offset_x) {
-        for (int i = 0; i < enemyCount; ++i) {
-            if (enemies[i] && enemies[i]->getIsAlive()) {
-                enemies[i]->draw(window, camera_offset_x);
+    int getCulledCount() const { return culled; }
+
+    // True if the box touches a living enemy or one of its projectiles.
+    // Only enemies and projectiles in the grid buckets under the box are tested,
+    // all in one CollisionBatch call.
+    bool collidesWith(float x, float y, float w, float h) {
+        candidates.clear();
+
+        nearby.clear();
+        enemyGrid.query(x, y, w, h, nearby);
+        for (size_t n = 0; n < nearby.size(); ++n) {
+            const EnemyStore& store = storeFor(nearby[n] % ENEMY_TYPE_COUNT);
+            int i = nearby[n] / ENEMY_TYPE_COUNT;
+            candidates.push(store.posX[i], store.posY[i], store.getWidth(), store.getHeight());
+        }
+
+        nearby.clear();
+        projectileGrid.query(x, y, w, h, nearby);
+        for (size_t n = 0; n < nearby.size(); ++n) {
+            FloatRect bounds;
+            if (projectiles.getBounds(nearby[n], bounds)) {
+                candidates.push(bounds.left, bounds.top, bounds.width, bounds.height);
             }
         }
+
+        return CollisionBatch::test(x, y, w, h, candidates, hits) > 0;
+    }
+
+    int getEnemyCount() const {
+        return batBrains.size() + beeBots.size() + motobugs.size() + crabMeats.size();
     }
+    int getEnemyCount(int type) const { return storeFor(type).size(); }
+    int getProjectileCount() const { return projectiles.getActiveCount(); }
+
+    // Read-only view of one enemy type's arrays (for stats and debug output)
+    const EnemyStore& getStore(int type) const { return storeFor(type); }
 
-    int getEnemyCount() const { return enemyCount; }
-    Enemy* getEnemy(int idx) const { return (idx >= 0 && idx < enemyCount) ? enemies[idx] : nullptr; }
+    static const char* getTypeName(int type) {
+        static const char* const names[ENEMY_TYPE_COUNT] = { "BatBrain", "BeeBot", "Motobug", "CrabMeat" };
+        return (type >= 0 && type < ENEMY_TYPE_COUNT) ? names[type] : "?";
+    }
 };
 
-#endif // ENEMY_MANAGER_H 
\ No newline at end of file
+#endif // ENEMY_MANAGER_H
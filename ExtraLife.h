@@ -13,23 +13,22 @@ class Player;
 
 class ExtraLife : public Collectible {
 private:
-    static Texture extraLifeTexture;
+    TextureRegion extraLifeTexture;
     Sprite sprite;
     HealthManager* healthManager;
     float hoverTimer;
     float baseY;
-    static float hoverAmplitude; // pixels
-    static float hoverSpeed; // radians/sec
+    static inline float hoverAmplitude = 8.0f; // pixels
+    static inline float hoverSpeed = 2.0f; // radians/sec
 
 public:
     ExtraLife(float startX, float startY, HealthManager* healthMgr, float scale = 2.0f)
         : Collectible(startX, startY, scale), healthManager(healthMgr), hoverTimer(0.0f), baseY(startY) {
         width = 16 * scale;
         height = 16 * scale;
-        if (extraLifeTexture.getSize().x == 0) {
-            extraLifeTexture.loadFromFile("Data/extralife.png");
-        }
-        sprite.setTexture(extraLifeTexture);
+        TextureCache::getInstance().acquireRegion("Data/extralife.png", extraLifeTexture);
+        sprite.setTexture(*extraLifeTexture.texture);
+        sprite.setTextureRect(extraLifeTexture.rect);
         sprite.setScale(scale, scale);
         sprite.setPosition(x, y);
     }
@@ -42,10 +41,15 @@ public:
         }
     }
 
-    void draw(RenderWindow& window, float camera_offset_x) override {
+    void draw(SpriteBatch& batch, float camera_offset_x) const override {
         if (!isCollected && isVisible) {
-            sprite.setPosition(x - camera_offset_x, sprite.getPosition().y);
-            window.draw(sprite);
+            batch.submit(sprite, x - camera_offset_x, sprite.getPosition().y, LAYER_COLLECTIBLES);
+        }
+    }
+
+    void capture(RenderSnapshot& snapshot) const override {
+        if (!isCollected && isVisible) {
+            snapshot.addSprite(sprite, x, sprite.getPosition().y, LAYER_COLLECTIBLES);
         }
     }
 
@@ -57,10 +61,7 @@ public:
 
     bool checkCollision(float playerX, float playerY, int playerWidth, int playerHeight) override {
         if (isCollected || !isVisible) return false;
-        return (playerX < x + width &&
-                playerX + playerWidth > x &&
-                playerY < y + height &&
-                playerY + playerHeight > y);
+        return boxesOverlap(playerX, playerY, playerWidth, playerHeight, x, y, width, height);
     }
 
     std::string getType() const override {
@@ -68,11 +69,4 @@ public:
     }
 };
 
-// Static texture definition
-Texture ExtraLife::extraLifeTexture;
-
-// Static variable definitions
-float ExtraLife::hoverAmplitude = 8.0f;
-float ExtraLife::hoverSpeed = 2.0f;
-
 #endif // EXTRALIFE_H 
\ No newline at end of file
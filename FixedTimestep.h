@@ -0,0 +1,24 @@
+#ifndef FIXED_TIMESTEP_H
+#define FIXED_TIMESTEP_H
+
+// The simulation advances in fixed ticks, independent of the display refresh rate.
+// Rendering interpolates between the last two ticks.
+const float SIM_TICK_RATE = 120.0f;
+const float SIM_DT = 1.0f / SIM_TICK_RATE;
+
+// Longest frame time fed into the accumulator, so a stall (window drag, breakpoint)
+// doesn't make the simulation try to catch up on seconds of ticks at once
+const float MAX_FRAME_TIME = 0.25f;
+
+// Player physics constants (acceleration, gravity, velocities in pixels per frame) were
+// tuned for 60 updates per second. Per-tick changes are scaled by this factor so the
+// game plays the same at any tick rate.
+const float PHYSICS_REFERENCE_RATE = 60.0f;
+const float PHYSICS_STEP = PHYSICS_REFERENCE_RATE / SIM_TICK_RATE;
+
+// Blend between the previous and current tick's value for drawing
+inline float interpolate(float previous, float current, float alpha) {
+    return previous + (current - previous) * alpha;
+}
+
+#endif // FIXED_TIMESTEP_H
@@ -0,0 +1,272 @@
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Trace.h"
+
+using namespace sf;
+using namespace std;
+
+// Parts of a frame that are timed separately. The simulation phases run once per
+// tick, so a frame that catches up on several ticks counts all of them.
+enum ProfilePhase {
+    PHASE_STREAMING = 0,    // Loading / dropping chunks of long levels
+    PHASE_INPUT,
+    PHASE_PHYSICS,
+    PHASE_TRANSITION,
+    PHASE_COLLECTIBLES,
+    PHASE_ENEMIES,
+    PHASE_COLLISION,
+    PHASE_LOADING,      // Texture uploads of a zone being preloaded
+    PHASE_HUD,
+    PHASE_DRAW,
+    PHASE_DISPLAY,      // window.display(), including the wait for vsync
+    PHASE_COUNT
+};
+
+// Times the phases of each frame into a ring buffer of the last HISTORY_FRAMES
+// frames. F3 toggles an overlay with a frame-time graph and each phase's average
+// and 99th percentile, plus any counters set for the frame (e.g. how many entities
+// were culled); writeCsv dumps the buffer (GameManager does on exit).
+class FrameProfiler {
+public:
+    static const int HISTORY_FRAMES = 240;
+
+private:
+    typedef chrono::steady_clock ProfileClock;
+
+    struct Counter {
+        string name;
+        int value;
+    };
+
+    struct FrameRecord {
+        float totalMs;
+        float phaseMs[PHASE_COUNT];
+    };
+
+    vector<FrameRecord> history;
+    int nextFrame;                  // Ring buffer slot of the frame being recorded
+    int recordedFrames;
+    long long frameNumber;
+    ProfileClock::time_point frameStart;
+    FrameRecord current;
+    bool overlayVisible;
+    vector<Counter> counters;       // Latest value of each, in the order first set
+
+    // Overlay statistics, refreshed a few times a second rather than every frame
+    float averageMs[PHASE_COUNT + 1];   // Index PHASE_COUNT is the whole frame
+    float p99Ms[PHASE_COUNT + 1];
+    int framesUntilRefresh;
+    vector<float> scratch;
+
+    RectangleShape background;
+    VertexArray graph;
+    Text text;
+
+    static float msSince(ProfileClock::time_point start) {
+        return chrono::duration<float, milli>(ProfileClock::now() - start).count();
+    }
+
+    const FrameRecord& recorded(int age) const {
+        return history[(nextFrame - 1 - age + HISTORY_FRAMES * 2) % HISTORY_FRAMES];
+    }
+
+    float sampleOf(const FrameRecord& frame, int phase) const {
+        return phase == PHASE_COUNT ? frame.totalMs : frame.phaseMs[phase];
+    }
+
+    void refreshStatistics() {
+        for (int phase = 0; phase <= PHASE_COUNT; phase++) {
+            scratch.clear();
+            float sum = 0;
+            for (int age = 0; age < recordedFrames; age++) {
+                float ms = sampleOf(recorded(age), phase);
+                scratch.push_back(ms);
+                sum += ms;
+            }
+            if (scratch.empty()) {
+                averageMs[phase] = p99Ms[phase] = 0;
+                continue;
+            }
+            averageMs[phase] = sum / scratch.size();
+            size_t rank = (scratch.size() * 99) / 100;
+            if (rank >= scratch.size()) rank = scratch.size() - 1;
+            nth_element(scratch.begin(), scratch.begin() + rank, scratch.end());
+            p99Ms[phase] = scratch[rank];
+        }
+    }
+
+    // One table row; columns are placed separately since the font isn't monospaced
+    void drawRow(RenderWindow& window, float y, const char* name, const char* average, const char* p99) {
+        const float columns[3] = { 768.0f, 960.0f, 1070.0f };
+        const char* cells[3] = { name, average, p99 };
+        for (int c = 0; c < 3; c++) {
+            text.setString(cells[c]);
+            text.setPosition(columns[c], y);
+            window.draw(text);
+        }
+    }
+
+public:
+    FrameProfiler()
+        : history(HISTORY_FRAMES), nextFrame(0), recordedFrames(0), frameNumber(0),
+          overlayVisible(false), framesUntilRefresh(0), graph(Quads) {
+        current = FrameRecord();
+        for (int phase = 0; phase <= PHASE_COUNT; phase++) {
+            averageMs[phase] = p99Ms[phase] = 0;
+        }
+        background.setFillColor(Color(0, 0, 0, 180));
+    }
+
+    static const char* getPhaseName(int phase) {
+        static const char* const names[PHASE_COUNT] = {
+            "streaming", "input", "physics", "transition", "collectibles", "enemies", "collision", "loading", "hud", "draw", "display"
+        };
+        return (phase >= 0 && phase < PHASE_COUNT) ? names[phase] : "frame";
+    }
+
+    void beginFrame() {
+        current = FrameRecord();
+        frameStart = ProfileClock::now();
+    }
+
+    void endFrame() {
+        current.totalMs = msSince(frameStart);
+        history[nextFrame] = current;
+        nextFrame = (nextFrame + 1) % HISTORY_FRAMES;
+        if (recordedFrames < HISTORY_FRAMES) recordedFrames++;
+        frameNumber++;
+    }
+
+    void addPhaseTime(ProfilePhase phase, float ms) { current.phaseMs[phase] += ms; }
+
+    // Show a count on the overlay until it is set again
+    void setCounter(const char* name, int value) {
+        for (size_t i = 0; i < counters.size(); i++) {
+            if (counters[i].name == name) {
+                counters[i].value = value;
+                return;
+            }
+        }
+        Counter counter;
+        counter.name = name;
+        counter.value = value;
+        counters.push_back(counter);
+    }
+
+    // Times its own lifetime into a phase of the current frame, and into the session
+    // trace while one is recording; does nothing otherwise
+    class Scope {
+    private:
+        FrameProfiler* profiler;
+        ProfilePhase phase;
+        bool traced;
+        ProfileClock::time_point start;
+
+    public:
+        Scope(FrameProfiler* owner, ProfilePhase timedPhase) : profiler(owner), phase(timedPhase), traced(TRACE_ENABLED()) {
+            if (profiler || traced) start = ProfileClock::now();
+        }
+        ~Scope() {
+            if (!profiler && !traced) return;
+            ProfileClock::time_point end = ProfileClock::now();
+            if (profiler) profiler->addPhaseTime(phase, chrono::duration<float, milli>(end - start).count());
+            if (traced) Trace::complete("frame", getPhaseName(phase), Trace::toNs(start), Trace::toNs(end));
+        }
+    };
+
+    void toggleOverlay() {
+        overlayVisible = !overlayVisible;
+        framesUntilRefresh = 0;
+    }
+    bool isOverlayVisible() const { return overlayVisible; }
+
+    // Graph of the recorded frames (the line is the 60 FPS budget) and a table of phases
+    void drawOverlay(RenderWindow& window, const Font& font) {
+        if (!overlayVisible) return;
+        if (--framesUntilRefresh <= 0) {
+            refreshStatistics();
+            framesUntilRefresh = 15;
+        }
+
+        const float left = 760.0f, top = 110.0f, width = 420.0f;
+        const float graphHeight = 100.0f;
+        const float msScale = graphHeight / 33.3f;        // Graph tops out at two frame budgets
+        const float budgetMs = 1000.0f / 60.0f;
+        const float rowHeight = 20.0f;
+        float height = graphHeight + 30.0f + rowHeight * (PHASE_COUNT + 2 + counters.size());
+
+        background.setPosition(left, top);
+        background.setSize(Vector2f(width, height));
+        window.draw(background);
+
+        // One bar per frame, newest on the right; red once over budget
+        graph.clear();
+        float barWidth = width / HISTORY_FRAMES;
+        float baseline = top + graphHeight + 10.0f;
+        for (int age = 0; age < recordedFrames; age++) {
+            float ms = recorded(age).totalMs;
+            float barHeight = min(graphHeight, ms * msScale);
+            float x = left + width - (age + 1) * barWidth;
+            Color color = ms > budgetMs ? Color::Red : Color::Green;
+            graph.append(Vertex(Vector2f(x, baseline - barHeight), color));
+            graph.append(Vertex(Vector2f(x + barWidth, baseline - barHeight), color));
+            graph.append(Vertex(Vector2f(x + barWidth, baseline), color));
+            graph.append(Vertex(Vector2f(x, baseline), color));
+        }
+        float budgetY = baseline - budgetMs * msScale;
+        graph.append(Vertex(Vector2f(left, budgetY), Color::Yellow));
+        graph.append(Vertex(Vector2f(left + width, budgetY), Color::Yellow));
+        graph.append(Vertex(Vector2f(left + width, budgetY + 1), Color::Yellow));
+        graph.append(Vertex(Vector2f(left, budgetY + 1), Color::Yellow));
+        window.draw(graph);
+
+        text.setFont(font);
+        text.setCharacterSize(16);
+        text.setFillColor(Color::White);
+        float y = baseline + 8.0f;
+        drawRow(window, y, "phase", "avg ms", "p99 ms");
+        char average[16], p99[16];
+        for (int phase = 0; phase <= PHASE_COUNT; phase++) {
+            y += rowHeight;
+            snprintf(average, sizeof(average), "%.2f", averageMs[phase]);
+            snprintf(p99, sizeof(p99), "%.2f", p99Ms[phase]);
+            drawRow(window, y, getPhaseName(phase), average, p99);
+        }
+        char value[16];
+        for (size_t i = 0; i < counters.size(); i++) {
+            y += rowHeight;
+            snprintf(value, sizeof(value), "%d", counters[i].value);
+            drawRow(window, y, counters[i].name.c_str(), value, "");
+        }
+    }
+
+    // The recorded frames, oldest first: frame number, total and one column per phase (ms)
+    bool writeCsv(const string& filename) const {
+        ofstream out(filename);
+        if (!out.is_open()) {
+            cout << "Failed to write frame profile: " << filename << endl;
+            return false;
+        }
+        out << "frame,total_ms";
+        for (int phase = 0; phase < PHASE_COUNT; phase++) out << "," << getPhaseName(phase) << "_ms";
+        out << "\n";
+        for (int age = recordedFrames - 1; age >= 0; age--) {
+            const FrameRecord& frame = recorded(age);
+            out << frameNumber - 1 - age << "," << frame.totalMs;
+            for (int phase = 0; phase < PHASE_COUNT; phase++) out << "," << frame.phaseMs[phase];
+            out << "\n";
+        }
+        return true;
+    }
+};
+
+#endif // FRAME_PROFILER_H
@@ -1,17 +1,107 @@
 #include <SFML/Graphics.hpp>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <string>
 #include "menu.h"
 #include "GameManager.h"
+#include "GameSimulation.h"
+#include "InputState.h"
+#include "Trace.h"
+#include "AssetPreloader.h"
 
 using namespace sf;
 
-int main()
+// Play a replay through the simulation without a window, audio or textures.
+// The profile-guided build (tools/pgo.sh) trains the game binary this way.
+// level: starting zone, or 0 for the one the replay was recorded in (default 1)
+static int playReplay(const std::string& replayPath, int level)
 {
-    RenderWindow window(VideoMode(1200, 900), "Sonic Game");
-    int selectedLevel = showMenu(window);
-    if (selectedLevel > 0) {
-        GameManager game(selectedLevel);
-        game.run();
+    TextureCache::getInstance().setLoadingEnabled(false);
+    AudioManager::disableBeforeUse();
+
+    ReplayInput replay;
+    if (!replay.loadFromFile(replayPath)) {
+        return 1;
+    }
+    Level::setSpawnSeed(replay.getSeed() ? replay.getSeed() : 1);
+    if (level == 0) {
+        level = replay.getLevel();
     }
+    GameSimulation simulation(level < 1 || level > 3 ? 1 : level);
+    while (!replay.isFinished() && !simulation.isGameOver()) {
+        simulation.tick(replay.poll());
+        simulation.getLevelManager().pumpPreload();
+    }
+    simulation.printState(std::cout);
     return 0;
+}
+
+int main(int argc, char** argv)
+{
+    // --record <file>: save this session's input as a replay for the headless runner
+    // --replay <file> [--level N]: play a replay without opening a window
+    // --profile <file>: write the frame profiler's last frames there as CSV on exit
+    // --trace <file>: record the session as a Chrome trace (open it in Perfetto)
+    // --threaded: simulate on a second thread, the main thread only draws
+    std::string recordPath;
+    std::string profilePath;
+    std::string tracePath;
+    std::string replayPath;
+    int replayLevel = 0;    // 0 = as recorded
+    bool threaded = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threaded") == 0) {
+            threaded = true;
+        }
+    }
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--record") == 0) {
+            recordPath = argv[i + 1];
+        }
+        else if (strcmp(argv[i], "--replay") == 0) {
+            replayPath = argv[i + 1];
+        }
+        else if (strcmp(argv[i], "--profile") == 0) {
+            profilePath = argv[i + 1];
+        }
+        else if (strcmp(argv[i], "--trace") == 0) {
+            tracePath = argv[i + 1];
+        }
+        else if (strcmp(argv[i], "--level") == 0) {
+            replayLevel = atoi(argv[i + 1]);
+        }
+    }
+    if (!tracePath.empty()) {
+        Trace::start();
+        TRACE_THREAD_NAME("main");
+    }
+
+    int result = 0;
+    if (!replayPath.empty()) {
+        result = playReplay(replayPath, replayLevel < 0 || replayLevel > 3 ? 1 : replayLevel);
+    }
+    else {
+        // Decode the intro, menu and HUD assets on worker threads while the window
+        // opens and the intro plays; one window serves the menu and the game
+        requestMenuAssets();
+        AssetPreloader::getInstance().requestFont(GameManager::HUD_FONT_FILE);
+        RenderWindow window(VideoMode(1200, 900), "Sonic Game");
+        int selectedLevel = showMenu(window);
+        if (selectedLevel > 0 && window.isOpen()) {
+            if (!recordPath.empty()) {
+                // Spawn enemies from a fixed seed (not the clock), which the recording
+                // notes down, so replaying it rebuilds the same world
+                Level::setSpawnSeed(1);
+            }
+            GameManager game(window, selectedLevel, recordPath, profilePath, threaded);
+            game.run();
+        }
+    }
+
+    if (!tracePath.empty()) {
+        Trace::stop();
+        Trace::writeJson(tracePath);
+    }
+    return result;
 }
\ No newline at end of file
@@ -1,144 +1,344 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include "ScoreManager.h"
-#include "HealthManager.h"
-#include "PlayerManager.h"
-#include "LevelManager.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include "GameSimulation.h"
+#include "InputState.h"
 #include "menu.h"
+#include "FixedTimestep.h"
+#include "FrameProfiler.h"
+#include "AssetPreloader.h"
+#include "RenderSnapshot.h"
+#include "TripleBuffer.h"
+#include "Hud.h"
+#include "SpriteBatch.h"
 
 using namespace sf;
 
 class GameManager {
 private:
-    RenderWindow window;
-    ScoreManager scoreManager;
-    HealthManager healthManager;
-    PlayerManager playerManager;
-    LevelManager levelManager;
+    RenderWindow& window;     // The menu's window, reused
+    GameSimulation simulation;
+    KeyboardInput keyboard;
+    InputRecorder* recorder;  // Set when the session is being recorded to a replay file
     float camera_offset_x;
     Font font;
-    Text scoreText;
-    Text healthText;
-    Text levelText;
-    Clock deltaClock;
-    int startLevelIndex;
+    Hud hud;
+    int scoreField;
+    int healthField;
+    int levelField;
+    int ringField;
+    int boostField;
+    int flightField;
+    int timeField;
+    Clock frameClock;
+    SpriteBatch spriteBatch;  // Obstacles, items, enemies, shots and players, drawn together
+    FrameProfiler profiler;
+    std::string profilePath;  // Where the profiler's frames are written on exit
+
+    // Two-thread mode (see runThreaded)
+    bool threaded;
+    TripleBuffer<RenderSnapshot> snapshots;
+    SnapshotRenderer snapshotRenderer;
+    std::atomic<bool> simulationRunning;
 
 public:
-    GameManager(int startLevelIndex_ = 1)
-        : window(VideoMode(1200, 900), "Sonic Game"),
-          playerManager(&healthManager),
-          levelManager(&playerManager, &scoreManager, &healthManager),
+    static constexpr const char* HUD_FONT_FILE = "Data/Gaslight_Regular.ttf";
+
+    // recordPath: if not empty, every tick's input is written there as a replay
+    // profilePath: if not empty, the last frames' phase timings are written there as CSV
+    // threaded: run the simulation on its own thread (see runThreaded)
+    GameManager(RenderWindow& window_, int startLevelIndex_ = 1, const std::string& recordPath = "", const std::string& profilePath_ = "",
+                bool threaded_ = false)
+        : window(window_),
+          simulation(startLevelIndex_),
+          recorder(nullptr),
           camera_offset_x(0),
-          startLevelIndex(startLevelIndex_)
+          profilePath(profilePath_),
+          threaded(threaded_),
+          simulationRunning(false)
     {
-        window.setFramerateLimit(60);
-        if (!font.loadFromFile("Data/Gaslight_Regular.ttf")) {
+        simulation.setProfiler(&profiler);
+        if (!recordPath.empty()) {
+            recorder = new InputRecorder(&keyboard, recordPath, Level::getSpawnSeed(), startLevelIndex_);
+        }
+        // Simulation runs on its own fixed tick, so the display rate is free to vary
+        window.setVerticalSyncEnabled(true);
+        if (!AssetPreloader::getInstance().loadFont(HUD_FONT_FILE, font)) {
             // Handle error (font not found)
         }
-        // Score text - left side
-        scoreText.setFont(font);
-        scoreText.setCharacterSize(38);
-        scoreText.setFillColor(Color::Yellow);
-        scoreText.setPosition(20, 20);
-        
-        // Health text - left side below score
-        healthText.setFont(font);
-        healthText.setCharacterSize(34);
-        healthText.setFillColor(Color::Red);
-        healthText.setPosition(20, 65);
-        
-        // Level text - right side
-        levelText.setFont(font);
-        levelText.setCharacterSize(38);
-        levelText.setFillColor(Color::Cyan);
-        levelText.setPosition(1050, 20);
+        // Score, health, rings and ability timers on the left, level and time on the right
+        scoreField = hud.addField(font, "Score: ", 38, Color::Yellow, Vector2f(20, 20));
+        healthField = hud.addField(font, "Health: ", 34, Color::Red, Vector2f(20, 65));
+        ringField = hud.addField(font, "Rings: ", 34, Color::Yellow, Vector2f(20, 105));
+        boostField = hud.addField(font, "Boost: ", 28, Color::Blue, Vector2f(20, 145), HUD_SECONDS);
+        flightField = hud.addField(font, "Flight: ", 28, Color(255, 140, 0), Vector2f(20, 178), HUD_SECONDS);
+        levelField = hud.addField(font, "Level: ", 38, Color::Cyan, Vector2f(1050, 20));
+        timeField = hud.addField(font, "Time: ", 34, Color::Cyan, Vector2f(1050, 65), HUD_CLOCK);
+    }
+
+    ~GameManager() {
+        if (!profilePath.empty()) {
+            profiler.writeCsv(profilePath);
+        }
+        delete recorder;
     }
 
     void run() {
-        // Show menu first
-        // (Menu now handled in Source.cpp, so just set level)
-        levelManager.setCurrentLevelIndex(startLevelIndex - 1); // 0-based
+        if (threaded) {
+            runThreaded();
+            return;
+        }
+
+        // Fixed-timestep loop: the simulation always advances in SIM_DT ticks,
+        // rendering happens once per displayed frame and interpolates between ticks
+        float accumulator = 0.0f;
+        frameClock.restart();
+
         // Main game loop
         while (window.isOpen()) {
+            TRACE_SCOPE("frame", "frame");
+            profiler.beginFrame();
             Event event;
             while (window.pollEvent(event)) {
                 if (event.type == Event::Closed)
                     window.close();
+                // F3 shows the frame profiler
+                if (event.type == Event::KeyPressed && event.key.code == Keyboard::F3)
+                    profiler.toggleOverlay();
             }
 
-            // Get current player with null check
-            Player* currentPlayer = playerManager.getCurrentPlayer();
-            Level* currentLevel = levelManager.getCurrentLevel();
-            
-            if (!currentPlayer || !currentLevel) {
-                continue;  // Skip frame if player or level is null
+            float frameTime = frameClock.restart().asSeconds();
+            if (frameTime > MAX_FRAME_TIME) frameTime = MAX_FRAME_TIME;
+            accumulator += frameTime;
+
+            InputSource& input = recorder ? static_cast<InputSource&>(*recorder) : keyboard;
+            while (accumulator >= SIM_DT) {
+                if (simulation.tick(input.poll())) {
+                    camera_offset_x = 0;
+                }
+                accumulator -= SIM_DT;
             }
 
-            // Handle input only if not in transition
-            if (!levelManager.isInTransition()) {
-                playerManager.handleInput(currentLevel);
+            {
+                FrameProfiler::Scope scope(&profiler, PHASE_LOADING);
+                simulation.getLevelManager().pumpPreload();
+            }
+
+            render(accumulator / SIM_DT);
+            profiler.endFrame();
+
+            // Close the window if the game is over
+            if (simulation.isGameOver()) {
+                window.close();
             }
+        }
+    }
+
+private:
+    // Two-thread mode: the simulation ticks on its own thread and publishes a snapshot
+    // of what to draw after every tick; this thread polls events and draws the latest
+    // snapshot. A slow frame then only delays what is shown, not the ticks or the input
+    // sampling. Zones are still loaded and built here, where the GL context is. The
+    // profiler times this thread's frames; the simulation's phases are still in the
+    // session trace.
+    void runThreaded() {
+        simulation.setProfiler(nullptr);
+        simulation.getLevelManager().setThreadedLoading(true);
+        simulationRunning = true;
+        std::thread simulationThread(&GameManager::simulationLoop, this);
 
-            // Update physics only if not in transition
-            if (!levelManager.isInTransition()) {
-                playerManager.updatePhysics(currentLevel);
+        bool haveSnapshot = false;
+        while (window.isOpen()) {
+            TRACE_SCOPE("frame", "frame");
+            profiler.beginFrame();
+            Event event;
+            while (window.pollEvent(event)) {
+                if (event.type == Event::Closed)
+                    window.close();
+                if (event.type == Event::KeyPressed && event.key.code == Keyboard::F3)
+                    profiler.toggleOverlay();
             }
 
-            // Check for level transition
-            if (currentPlayer->needsLevelTransition()) {
-                levelManager.handleLevelTransition(currentPlayer);
+            {
+                FrameProfiler::Scope scope(&profiler, PHASE_LOADING);
+                simulation.getLevelManager().pumpPreload();
             }
 
-            // Update transition state
-            if (levelManager.updateTransition(currentPlayer)) {
-                camera_offset_x = 0;
+            if (snapshots.acquireLatest()) {
+                // Textures the simulation let go of are freed here, with the GL context
+                snapshots.readBuffer().releaseRetired();
+                haveSnapshot = true;
             }
+            if (!haveSnapshot) {
+                // Nothing to draw before the first tick
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            const RenderSnapshot& snapshot = snapshots.readBuffer();
+            renderSnapshot(snapshot);
+            profiler.endFrame();
 
-            // Update camera position only if not in transition
-            if (!levelManager.isInTransition()) {
-                float playerX = currentPlayer->getX();
-                if (playerX > 1200 / 2) {
-                    camera_offset_x = playerX - 1200 / 2;
-                }
+            if (snapshot.gameOver) {
+                window.close();
             }
+        }
+
+        simulationRunning = false;
+        simulation.getLevelManager().stopLoading();
+        simulationThread.join();
+    }
 
-            // Update collectibles (for ring animation)
-            float deltaTime = deltaClock.restart().asSeconds();
-            currentLevel->updateCollectibles(deltaTime);
+    // Simulation thread: one tick every SIM_DT, each followed by a snapshot. Falling
+    // more than MAX_FRAME_TIME behind drops the backlog, like the single-thread loop.
+    void simulationLoop() {
+        TRACE_THREAD_NAME("simulation");
+        typedef std::chrono::steady_clock TickClock;
+        const TickClock::duration tickLength = std::chrono::duration_cast<TickClock::duration>(std::chrono::duration<float>(SIM_DT));
+        const TickClock::duration maxLag = std::chrono::duration_cast<TickClock::duration>(std::chrono::duration<float>(MAX_FRAME_TIME));
 
-            // Update enemies
-            float playerX = currentPlayer->getX();
-            float playerY = currentPlayer->getY();
-            currentLevel->updateEnemies(deltaTime, playerX, playerY);
+        InputSource& input = recorder ? static_cast<InputSource&>(*recorder) : keyboard;
+        TickClock::time_point nextTick = TickClock::now();
+        while (simulationRunning) {
+            bool levelChanged = simulation.tick(input.poll());
+            publishSnapshot(levelChanged);
+            if (simulation.isGameOver()) {
+                return;
+            }
 
-            // Check for enemy or projectile collision and apply damage
-            if (!currentPlayer->getIsInvulnerable() && currentLevel->checkEnemyCollisions(playerX, playerY, currentPlayer->getWidth(), currentPlayer->getHeight())) {
-                //healthManager.decrementHealth();
-                //currentPlayer->takeDamage();
+            nextTick += tickLength;
+            TickClock::time_point now = TickClock::now();
+            if (now - nextTick > maxLag) {
+                nextTick = now;
             }
-            currentPlayer->updateInvulnerability();
+            std::this_thread::sleep_until(nextTick);
+        }
+    }
+
+    // Simulation thread: copy what render() would draw for this tick into the triple
+    // buffer. The camera follows the player tick by tick here (the renderer blends
+    // between the last two positions), so the snapshot only needs the world under them.
+    void publishSnapshot(bool levelChanged) {
+        TRACE_SCOPE("sim", "snapshot");
+        PlayerManager& playerManager = simulation.getPlayerManager();
+        LevelManager& levelManager = simulation.getLevelManager();
+        Player* currentPlayer = playerManager.getCurrentPlayer();
+        Level* currentLevel = levelManager.getCurrentLevel();
+        if (!currentPlayer || !currentLevel) {
+            return;
+        }
+
+        if (levelChanged) {
+            camera_offset_x = 0;
+        }
+        float previousCamera = camera_offset_x;
+        if (!levelManager.isInTransition()) {
+            camera_offset_x = currentLevel->cameraFor(currentPlayer->getX());
+        }
+
+        RenderSnapshot& snapshot = snapshots.writeBuffer();
+        snapshot.clear();
+        TextureCache::getInstance().collectResident(snapshot.textures);
+        float minX = std::min(previousCamera, camera_offset_x);
+        float maxX = std::max(previousCamera, camera_offset_x) + currentLevel->getScreenWidth();
+        levelManager.captureLevel(snapshot, minX, maxX);
+        currentLevel->captureEnemies(snapshot, minX, maxX);
+        playerManager.capture(snapshot);
+
+        snapshot.previousCamera = previousCamera;
+        snapshot.camera = camera_offset_x;
+        snapshot.hud = readHud();
+        snapshot.gameOver = simulation.isGameOver();
+        snapshot.tick = simulation.getTickCount();
+        snapshot.culled = currentLevel->getCulledCount();
+        snapshot.published = RenderSnapshot::SnapshotClock::now();
+        snapshots.publish();
+    }
+
+    // The HUD only re-lays out the fields whose value changed
+    // Read on the thread that runs the simulation
+    HudValues readHud() {
+        HudValues values;
+        values.score = simulation.getScoreManager().getScore();
+        values.health = simulation.getHealthManager().getHealth();
+        values.levelNumber = simulation.getLevelManager().getCurrentLevelIndex() + 1;
+        values.rings = simulation.getScoreManager().getRings();
+        values.boostCooldown = simulation.getPlayerManager().getBoostCooldown();
+        values.flightTime = simulation.getPlayerManager().getFlightTimeRemaining();
+        values.elapsed = simulation.getTickCount() * SIM_DT;
+        return values;
+    }
+
+    void updateHud(const HudValues& values) {
+        FrameProfiler::Scope scope(&profiler, PHASE_HUD);
+        hud.setValue(scoreField, values.score);
+        hud.setValue(healthField, values.health);
+        hud.setValue(levelField, values.levelNumber);
+        hud.setValue(ringField, values.rings);
+        hud.setSeconds(boostField, values.boostCooldown);
+        hud.setSeconds(flightField, values.flightTime);
+        hud.setSeconds(timeField, values.elapsed);
+    }
+
+    // Per-frame counts for the F3 overlay
+    void countFrame(int culled, const SpriteBatch& batch) {
+        profiler.setCounter("culled", culled);
+        profiler.setCounter("sprite draws", batch.getDrawCalls());
+        profiler.setCounter("sprite vertices", batch.getVertexCount());
+    }
 
-            // Update score text
-            scoreText.setString("Score: " + std::to_string(scoreManager.getScore()));
-            // Update health text
-            healthText.setString("Health: " + std::to_string(healthManager.getHealth()));
-            // Update level text
-            levelText.setString("Level: " + std::to_string(levelManager.getCurrentLevelIndex() + 1));
+    void drawHud() {
+        hud.draw(window);
+        profiler.drawOverlay(window, font);
+    }
 
-            // Draw everything
+    // Draw one frame from a snapshot (two-thread mode)
+    void renderSnapshot(const RenderSnapshot& snapshot) {
+        updateHud(snapshot.hud);
+        {
+            FrameProfiler::Scope scope(&profiler, PHASE_DRAW);
             window.clear(Color::White);
-            levelManager.drawLevel(window, camera_offset_x);
-            levelManager.getCurrentLevel()->drawEnemies(window, camera_offset_x);
-            playerManager.draw(window, camera_offset_x);
-            window.draw(scoreText);
-            window.draw(healthText);
-            window.draw(levelText);
-            window.display();
+            snapshotRenderer.draw(window, snapshot, SnapshotRenderer::alphaOf(snapshot));
+            countFrame(snapshot.culled, snapshotRenderer.getBatch());
+            drawHud();
+        }
+        FrameProfiler::Scope scope(&profiler, PHASE_DISPLAY);
+        window.display();
+    }
 
-            // Close the window if the game is over
-            if (Player::isGameOverState()) {
-                window.close();
-            }
+    // Draw one frame; alpha is how far we are between the last two ticks
+    void render(float alpha) {
+        PlayerManager& playerManager = simulation.getPlayerManager();
+        LevelManager& levelManager = simulation.getLevelManager();
+        Player* currentPlayer = playerManager.getCurrentPlayer();
+        Level* currentLevel = levelManager.getCurrentLevel();
+        if (!currentPlayer || !currentLevel) {
+            return;
+        }
+
+        // Update camera position only if not in transition; follow the
+        // interpolated position so scrolling is as smooth as the sprites
+        if (!levelManager.isInTransition()) {
+            camera_offset_x = currentLevel->cameraFor(currentPlayer->getRenderX(alpha));
+        }
+
+        updateHud(readHud());
+
+        // Draw everything
+        {
+            FrameProfiler::Scope scope(&profiler, PHASE_DRAW);
+            window.clear(Color::White);
+            levelManager.drawLevel(window, spriteBatch, camera_offset_x);
+            currentLevel->drawEnemies(spriteBatch, camera_offset_x, alpha);
+            playerManager.draw(spriteBatch, camera_offset_x, alpha);
+            spriteBatch.flush(window);
+            countFrame(currentLevel->getCulledCount(), spriteBatch);
+            drawHud();
         }
+        FrameProfiler::Scope scope(&profiler, PHASE_DISPLAY);
+        window.display();
     }
 };
\ No newline at end of file
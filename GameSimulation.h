@@ -0,0 +1,168 @@
+#ifndef GAME_SIMULATION_H
+#define GAME_SIMULATION_H
+
+#include <iostream>
+#include "ScoreManager.h"
+#include "HealthManager.h"
+#include "PlayerManager.h"
+#include "LevelManager.h"
+#include "InputState.h"
+#include "FixedTimestep.h"
+#include "FrameProfiler.h"
+
+using namespace std;
+
+// The game world without a window: players, levels, enemies, score and health,
+// advanced one fixed tick at a time from an InputState. GameManager drives it from
+// the keyboard and draws it; Headless.cpp runs it as fast as the CPU allows.
+class GameSimulation {
+private:
+    ScoreManager scoreManager;
+    HealthManager healthManager;
+    PlayerManager playerManager;
+    LevelManager levelManager;
+    unsigned long long tickCount;
+    FrameProfiler* profiler;      // Times the phases of each tick when set
+
+public:
+    GameSimulation(int startLevelIndex = 1)
+        : playerManager(&healthManager),
+          levelManager(&playerManager, &scoreManager, &healthManager, startLevelIndex - 1),
+          tickCount(0),
+          profiler(nullptr)
+    {
+        levelManager.setCurrentLevelIndex(startLevelIndex - 1); // 0-based
+    }
+
+    // Advance the game by one fixed simulation step.
+    // Returns true when a level transition finished on this tick.
+    bool tick(const InputState& input) {
+        TRACE_SCOPE("sim", "tick");
+        // Get current player with null check
+        Player* currentPlayer = playerManager.getCurrentPlayer();
+        Level* currentLevel = levelManager.getCurrentLevel();
+
+        if (!currentPlayer || !currentLevel) {
+            return false;  // Skip tick if player or level is null
+        }
+        tickCount++;
+
+        // Streamed levels load and drop chunks around the player
+        {
+            FrameProfiler::Scope scope(profiler, PHASE_STREAMING);
+            currentLevel->updateStreaming(currentPlayer->getX());
+        }
+
+        playerManager.storePreviousPositions();
+
+        // Handle input only if not in transition
+        if (!levelManager.isInTransition()) {
+            FrameProfiler::Scope scope(profiler, PHASE_INPUT);
+            playerManager.handleInput(currentLevel, input);
+        }
+
+        // Update physics only if not in transition
+        if (!levelManager.isInTransition()) {
+            FrameProfiler::Scope scope(profiler, PHASE_PHYSICS);
+            playerManager.updatePhysics(currentLevel);
+        }
+
+        // The switch key may have changed the current character
+        currentPlayer = playerManager.getCurrentPlayer();
+
+        bool levelChanged;
+        {
+            FrameProfiler::Scope scope(profiler, PHASE_TRANSITION);
+            levelManager.preloadAhead(currentPlayer->getX());
+
+            // Check for level transition
+            if (currentPlayer->needsLevelTransition()) {
+                levelManager.handleLevelTransition(currentPlayer);
+            }
+
+            // Update transition state
+            levelChanged = levelManager.updateTransition(currentPlayer);
+        }
+
+        // The transition may have swapped the level
+        currentLevel = levelManager.getCurrentLevel();
+        if (!currentLevel) {
+            return levelChanged;
+        }
+
+        float playerX = currentPlayer->getX();
+        float playerY = currentPlayer->getY();
+
+        // Update on-screen collectibles (for ring animation)
+        {
+            FrameProfiler::Scope scope(profiler, PHASE_COLLECTIBLES);
+            currentLevel->updateCollectibles(SIM_DT, playerX);
+        }
+
+        // Update enemies
+        {
+            FrameProfiler::Scope scope(profiler, PHASE_ENEMIES);
+            currentLevel->updateEnemies(SIM_DT, playerX, playerY);
+        }
+
+        // Check for enemy or projectile collision and apply damage
+        FrameProfiler::Scope scope(profiler, PHASE_COLLISION);
+        if (!currentPlayer->getIsInvulnerable() && currentLevel->checkEnemyCollisions(playerX, playerY, currentPlayer->getWidth(), currentPlayer->getHeight())) {
+            //healthManager.decrementHealth();
+            //currentPlayer->takeDamage();
+        }
+        currentPlayer->updateInvulnerability(SIM_DT);
+        return levelChanged;
+    }
+
+    // Time each phase of a tick into profiler's current frame (nullptr to stop)
+    void setProfiler(FrameProfiler* frameProfiler) { profiler = frameProfiler; }
+
+    bool isGameOver() const { return Player::isGameOverState(); }
+    unsigned long long getTickCount() const { return tickCount; }
+
+    ScoreManager& getScoreManager() { return scoreManager; }
+    HealthManager& getHealthManager() { return healthManager; }
+    PlayerManager& getPlayerManager() { return playerManager; }
+    LevelManager& getLevelManager() { return levelManager; }
+
+    // Human-readable dump of the world, used by the headless runner
+    void printState(ostream& out) {
+        out << "ticks: " << tickCount << " (" << tickCount * SIM_DT << " s)" << endl;
+        out << "level: " << levelManager.getCurrentLevelIndex() + 1
+            << (levelManager.isInTransition() ? " (transitioning)" : "") << endl;
+        out << "score: " << scoreManager.getScore() << endl;
+        out << "health: " << healthManager.getHealth() << (isGameOver() ? " (game over)" : "") << endl;
+
+        static const char* const names[3] = { "Sonic", "Tails", "Knuckles" };
+        for (int i = 0; i < 3; i++) {
+            Player* player = playerManager.getCharacter(i);
+            out << (player == playerManager.getCurrentPlayer() ? "* " : "  ") << names[i]
+                << " pos=(" << player->getX() << ", " << player->getY() << ")"
+                << " vel=(" << player->getVelX() << ", " << player->getVelY() << ")"
+                << (player->isOnGround() ? " grounded" : " airborne")
+                << (player->isAbilityActive() ? " ability" : "") << endl;
+        }
+
+        Level* level = levelManager.getCurrentLevel();
+        EnemyManager* enemies = level->getEnemyManager();
+        int alive = 0;
+        for (int type = 0; type < ENEMY_TYPE_COUNT; type++) {
+            const EnemyStore& store = enemies->getStore(type);
+            for (int i = 0; i < store.size(); i++) {
+                if (store.alive[i]) alive++;
+            }
+        }
+        out << "enemies: " << alive << "/" << enemies->getEnemyCount() << " alive, "
+            << enemies->getProjectileCount() << " shots in flight" << endl;
+        for (int type = 0; type < ENEMY_TYPE_COUNT; type++) {
+            const EnemyStore& store = enemies->getStore(type);
+            for (int i = 0; i < store.size(); i++) {
+                out << "  " << EnemyManager::getTypeName(type) << "[" << i << "] pos=(" << store.posX[i] << ", " << store.posY[i] << ")"
+                    << (store.alive[i] ? " alive" : " dead") << endl;
+            }
+        }
+    }
+};
+
+#endif // GAME_SIMULATION_H
@@ -0,0 +1,149 @@
+// Headless game runner.
+//
+// Runs the game simulation without a window, audio or textures for a fixed number
+// of ticks, as fast as the CPU allows, then prints the final state. Input comes from
+// a replay file (see InputState.h) or is left idle. Used for soak tests and perf
+// regression runs on machines without a display.
+//
+// Usage: sonic-headless [--level N] [--ticks N] [--replay file] [--layout file] [--enemies N] [--seed N] [--trace file] [--quiet]
+//   --level   zone to start in (1-3; default: the replay's, or 1)
+//   --ticks   ticks to run (default: length of the replay, or 10 seconds of game time)
+//   --replay  input file recorded with `sonic-heroes --record file`
+//   --layout  play this layout file in the starting zone instead of its own
+//             (layouts wider than 1024 columns are streamed)
+//   --enemies replace the zone's enemies with N randomly placed ones (stress runs)
+//   --seed    enemy spawn seed (default: the replay's, or 1, so runs are reproducible)
+//   --trace   write the run as a Chrome trace (zone loads, ticks and their phases)
+//   --quiet   only print the final state, not the timing line
+//
+// Run it from the game directory (the one containing Data/).
+
+#include <SFML/System.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "AudioManager.h"
+#include "TextureCache.h"
+#include "GameSimulation.h"
+#include "InputState.h"
+#include "Trace.h"
+
+using namespace sf;
+using namespace std;
+
+// Input source that never presses anything
+class IdleInput : public InputSource {
+public:
+    InputState poll() override { return InputState(); }
+};
+
+static void printUsage() {
+    cout << "Usage: sonic-headless [--level N] [--ticks N] [--replay file] [--layout file] [--enemies N] [--seed N] [--trace file] [--quiet]" << endl;
+}
+
+int main(int argc, char** argv) {
+    int level = 1;
+    long long ticks = -1;
+    string replayPath;
+    string layoutPath;
+    string tracePath;
+    int enemyCount = -1;
+    unsigned int seed = 1;
+    bool levelGiven = false, seedGiven = false;
+    bool quiet = false;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--level") == 0 && hasValue) {
+            level = atoi(argv[++i]);
+            levelGiven = true;
+        }
+        else if (strcmp(argv[i], "--ticks") == 0 && hasValue) {
+            ticks = atoll(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--replay") == 0 && hasValue) {
+            replayPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--layout") == 0 && hasValue) {
+            layoutPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--enemies") == 0 && hasValue) {
+            enemyCount = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            seed = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+            seedGiven = true;
+        }
+        else if (strcmp(argv[i], "--trace") == 0 && hasValue) {
+            tracePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--quiet") == 0) {
+            quiet = true;
+        }
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    // A recorded replay says which zone and seed it was recorded with
+    ReplayInput replay;
+    IdleInput idle;
+    InputSource* input = &idle;
+    if (!replayPath.empty()) {
+        if (!replay.loadFromFile(replayPath)) {
+            return 1;
+        }
+        input = &replay;
+        if (ticks < 0) ticks = static_cast<long long>(replay.getTotalTicks());
+        if (!levelGiven && replay.getLevel()) level = replay.getLevel();
+        if (!seedGiven && replay.getSeed()) seed = replay.getSeed();
+    }
+    if (level < 1 || level > 3) {
+        cout << "Level must be 1-3" << endl;
+        return 1;
+    }
+
+    // No display, no audio device
+    TextureCache::getInstance().setLoadingEnabled(false);
+    AudioManager::disableBeforeUse();
+    Level::setSpawnSeed(seed);
+    if (!tracePath.empty()) {
+        Trace::start();
+        TRACE_THREAD_NAME("main");
+    }
+    if (ticks < 0) ticks = static_cast<long long>(10 * SIM_TICK_RATE);
+
+    GameSimulation simulation(level);
+    if (!layoutPath.empty() && !simulation.getLevelManager().getCurrentLevel()->loadLayout(layoutPath)) {
+        return 1;
+    }
+    if (enemyCount >= 0) {
+        Level* current = simulation.getLevelManager().getCurrentLevel();
+        current->getEnemyManager()->clear();
+        current->spawnRandomEnemies(enemyCount);
+    }
+
+    Clock clock;
+    for (long long i = 0; i < ticks && !simulation.isGameOver(); i++) {
+        simulation.tick(input->poll());
+        simulation.getLevelManager().pumpPreload();
+    }
+    float elapsed = clock.getElapsedTime().asSeconds();
+
+    if (!tracePath.empty()) {
+        Trace::stop();
+        Trace::writeJson(tracePath);
+    }
+
+    simulation.printState(cout);
+    if (!quiet) {
+        cout << "ran " << simulation.getTickCount() << " ticks in " << elapsed << " s";
+        if (elapsed > 0) {
+            cout << " (" << static_cast<long long>(simulation.getTickCount() / elapsed) << " ticks/s)";
+        }
+        cout << endl;
+    }
+    return simulation.isGameOver() ? 2 : 0;
+}
@@ -0,0 +1,178 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace sf;
+using namespace std;
+
+// The glyphs numbers are made of, looked up once for one font and character size.
+// Numbers are laid out from these straight into a vertex array, the way sf::Text
+// would, without building a string or asking the font again.
+class GlyphStrip {
+public:
+    static constexpr const char* CHARACTERS = "0123456789.:-";
+    static const int CHARACTER_COUNT = 13;
+
+private:
+    const Font* font;
+    unsigned int characterSize;
+    Glyph glyphs[CHARACTER_COUNT];
+
+public:
+    GlyphStrip() : font(nullptr), characterSize(0) {}
+
+    void bake(const Font& source, unsigned int size) {
+        font = &source;
+        characterSize = size;
+        for (int i = 0; i < CHARACTER_COUNT; i++) {
+            glyphs[i] = source.getGlyph(CHARACTERS[i], size, false);
+        }
+    }
+
+    // The font page the glyphs live on (it may grow, but stays the same texture)
+    const Texture* getTexture() const { return font ? &font->getTexture(characterSize) : nullptr; }
+
+    // Append the quads of text at origin (the top left, as for sf::Text). Characters
+    // outside CHARACTERS are skipped.
+    void append(const char* text, Vector2f origin, Color color, VertexArray& out) const {
+        float x = origin.x;
+        float baseline = origin.y + characterSize;
+        for (const char* c = text; *c; c++) {
+            const char* found = strchr(CHARACTERS, *c);
+            if (!found) continue;
+            const Glyph& glyph = glyphs[found - CHARACTERS];
+            float left = x + glyph.bounds.left;
+            float top = baseline + glyph.bounds.top;
+            float right = left + glyph.bounds.width;
+            float bottom = top + glyph.bounds.height;
+            float u1 = static_cast<float>(glyph.textureRect.left);
+            float v1 = static_cast<float>(glyph.textureRect.top);
+            float u2 = u1 + glyph.textureRect.width;
+            float v2 = v1 + glyph.textureRect.height;
+            out.append(Vertex(Vector2f(left, top), color, Vector2f(u1, v1)));
+            out.append(Vertex(Vector2f(right, top), color, Vector2f(u2, v1)));
+            out.append(Vertex(Vector2f(right, bottom), color, Vector2f(u2, v2)));
+            out.append(Vertex(Vector2f(left, bottom), color, Vector2f(u1, v2)));
+            x += glyph.advance;
+        }
+    }
+};
+
+// What the game's HUD shows, read once per frame (or per snapshot in threaded mode)
+struct HudValues {
+    int score;
+    int health;
+    int levelNumber;
+    int rings;
+    float boostCooldown;    // Sonic
+    float flightTime;       // Tails, seconds of flight left
+    float elapsed;          // Seconds played
+
+    HudValues() : score(0), health(0), levelNumber(1), rings(0), boostCooldown(0), flightTime(0), elapsed(0) {}
+};
+
+// How a HUD field shows its value
+enum HudFormat {
+    HUD_NUMBER = 0,     // An integer
+    HUD_SECONDS,        // Seconds with one decimal (cooldowns, flight time)
+    HUD_CLOCK           // Whole seconds as m:ss (timers)
+};
+
+// Retained-mode HUD: each field is a fixed label and a number. Setting a value only
+// marks the field dirty if it changed; draw() re-lays out the digits of dirty fields
+// (a few quads, no allocation once the vertex arrays have grown) and otherwise draws
+// the same label and vertices every frame.
+class Hud {
+private:
+    struct Field {
+        Text label;
+        GlyphStrip digits;
+        VertexArray vertices;
+        Color color;
+        HudFormat format;
+        int value;          // As shown: HUD_SECONDS keeps tenths
+        bool dirty;
+    };
+
+    vector<Field> fields;
+
+    static void format(const Field& field, char* out, size_t size) {
+        switch (field.format) {
+            case HUD_SECONDS:
+                snprintf(out, size, "%d.%d", field.value / 10, field.value % 10);
+                break;
+            case HUD_CLOCK:
+                snprintf(out, size, "%d:%02d", field.value / 60, field.value % 60);
+                break;
+            default:
+                snprintf(out, size, "%d", field.value);
+                break;
+        }
+    }
+
+    void rebuild(Field& field) {
+        char text[24];
+        format(field, text, sizeof(text));
+        // Digits start where the label's text ends
+        Vector2f origin = field.label.findCharacterPos(field.label.getString().getSize());
+        field.vertices.clear();
+        field.digits.append(text, origin, field.color, field.vertices);
+        field.dirty = false;
+    }
+
+public:
+    // Add a field showing "<label><value>" at position; returns its index for set*()
+    int addField(const Font& font, const string& label, unsigned int characterSize, Color color, Vector2f position,
+                 HudFormat format = HUD_NUMBER) {
+        Field field;
+        field.label.setFont(font);
+        field.label.setString(label);
+        field.label.setCharacterSize(characterSize);
+        field.label.setFillColor(color);
+        field.label.setPosition(position);
+        field.digits.bake(font, characterSize);
+        field.vertices.setPrimitiveType(Quads);
+        field.color = color;
+        field.format = format;
+        field.value = 0;
+        field.dirty = true;
+        fields.push_back(field);
+        return static_cast<int>(fields.size()) - 1;
+    }
+
+    void setValue(int index, int value) {
+        Field& field = fields[index];
+        if (field.value != value) {
+            field.value = value;
+            field.dirty = true;
+        }
+    }
+
+    // For HUD_SECONDS / HUD_CLOCK fields: only changes what is shown (a tenth or a
+    // whole second) mark the field dirty
+    void setSeconds(int index, float seconds) {
+        float units = fields[index].format == HUD_SECONDS ? seconds * 10.0f : seconds;
+        setValue(index, static_cast<int>(floor(max(0.0f, units))));
+    }
+
+    void draw(RenderWindow& window) {
+        RenderStates states;
+        for (size_t i = 0; i < fields.size(); i++) {
+            Field& field = fields[i];
+            if (field.dirty) rebuild(field);
+            window.draw(field.label);
+            if (field.vertices.getVertexCount() == 0) continue;
+            states.texture = field.digits.getTexture();
+            window.draw(field.vertices, states);
+        }
+    }
+};
+
+#endif // HUD_H
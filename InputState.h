@@ -0,0 +1,195 @@
+#ifndef INPUT_STATE_H
+#define INPUT_STATE_H
+
+#include <SFML/Window.hpp>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace sf;
+using namespace std;
+
+// Game buttons, as bits of InputState::buttons
+enum InputButton {
+    INPUT_LEFT = 1 << 0,
+    INPUT_RIGHT = 1 << 1,
+    INPUT_UP = 1 << 2,        // Tails: fly up
+    INPUT_DOWN = 1 << 3,      // Tails: fly down
+    INPUT_JUMP = 1 << 4,
+    INPUT_ABILITY = 1 << 5,
+    INPUT_SWITCH = 1 << 6
+};
+
+// Buttons held during one simulation tick
+struct InputState {
+    unsigned int buttons;
+
+    InputState(unsigned int b = 0) : buttons(b) {}
+
+    bool isDown(InputButton button) const { return (buttons & button) != 0; }
+};
+
+// Where the simulation gets its input from; polled once per tick
+class InputSource {
+public:
+    virtual ~InputSource() = default;
+    virtual InputState poll() = 0;
+    // True once a finite source (e.g. a replay) has nothing left to give
+    virtual bool isFinished() const { return false; }
+};
+
+// Live keyboard
+class KeyboardInput : public InputSource {
+public:
+    InputState poll() override {
+        unsigned int buttons = 0;
+        if (Keyboard::isKeyPressed(Keyboard::Left)) buttons |= INPUT_LEFT;
+        if (Keyboard::isKeyPressed(Keyboard::Right)) buttons |= INPUT_RIGHT;
+        if (Keyboard::isKeyPressed(Keyboard::W)) buttons |= INPUT_UP;
+        if (Keyboard::isKeyPressed(Keyboard::S)) buttons |= INPUT_DOWN;
+        if (Keyboard::isKeyPressed(Keyboard::Space)) buttons |= INPUT_JUMP;
+        if (Keyboard::isKeyPressed(Keyboard::LControl)) buttons |= INPUT_ABILITY;
+        if (Keyboard::isKeyPressed(Keyboard::Z)) buttons |= INPUT_SWITCH;
+        return InputState(buttons);
+    }
+};
+
+// Replay files are run-length encoded, one run per line:
+//
+//   <tick count> <buttons>
+//
+// e.g. "120 2" holds Right for one second at 120 Hz. Lines starting with '#' are comments,
+// except the header a recording starts with:
+//
+//   # seed <enemy spawn seed>
+//   # level <starting zone>
+//
+// which the replay players apply, so a replay rebuilds the world it was recorded in.
+class ReplayInput : public InputSource {
+private:
+    struct Run {
+        unsigned long long ticks;
+        unsigned int buttons;
+    };
+
+    vector<Run> runs;
+    size_t runIndex;
+    unsigned long long tickInRun;
+    unsigned int seed;      // 0 = not in the file
+    int level;              // 0 = not in the file
+
+public:
+    ReplayInput() : runIndex(0), tickInRun(0), seed(0), level(0) {}
+
+    bool loadFromFile(const string& filename) {
+        runs.clear();
+        runIndex = 0;
+        tickInRun = 0;
+        seed = 0;
+        level = 0;
+
+        ifstream file(filename);
+        if (!file.is_open()) {
+            cout << "Failed to open replay: " << filename << endl;
+            return false;
+        }
+
+        string line;
+        while (getline(file, line)) {
+            if (line.empty()) continue;
+            if (line[0] == '#') {
+                istringstream header(line.substr(1));
+                string key;
+                if (!(header >> key)) continue;
+                if (key == "seed") header >> seed;
+                else if (key == "level") header >> level;
+                continue;
+            }
+            istringstream in(line);
+            Run run;
+            if (in >> run.ticks >> run.buttons && run.ticks > 0) {
+                runs.push_back(run);
+            }
+        }
+        return true;
+    }
+
+    InputState poll() override {
+        if (runIndex >= runs.size()) {
+            return InputState();
+        }
+        InputState state(runs[runIndex].buttons);
+        if (++tickInRun >= runs[runIndex].ticks) {
+            runIndex++;
+            tickInRun = 0;
+        }
+        return state;
+    }
+
+    bool isFinished() const override { return runIndex >= runs.size(); }
+
+    unsigned long long getTotalTicks() const {
+        unsigned long long total = 0;
+        for (size_t i = 0; i < runs.size(); i++) total += runs[i].ticks;
+        return total;
+    }
+
+    // The recording's spawn seed and starting zone, 0 if the file doesn't say
+    unsigned int getSeed() const { return seed; }
+    int getLevel() const { return level; }
+};
+
+// Passes another source through unchanged while writing it to a replay file
+class InputRecorder : public InputSource {
+private:
+    InputSource* source;
+    ofstream file;
+    unsigned int lastButtons;
+    unsigned long long runLength;
+
+    void flushRun() {
+        if (runLength > 0) {
+            file << runLength << " " << lastButtons << "\n";
+            runLength = 0;
+        }
+    }
+
+public:
+    // seed and level: the enemy spawn seed and starting zone of the recorded session
+    InputRecorder(InputSource* src, const string& filename, unsigned int seed, int level)
+        : source(src), lastButtons(0), runLength(0) {
+        file.open(filename);
+        if (!file.is_open()) {
+            cout << "Failed to open replay for writing: " << filename << endl;
+        }
+        else {
+            file << "# Sonic Classic Heroes replay: <ticks> <buttons>\n";
+            file << "# seed " << seed << "\n";
+            file << "# level " << level << "\n";
+        }
+    }
+
+    ~InputRecorder() {
+        if (file.is_open()) {
+            flushRun();
+        }
+    }
+
+    InputState poll() override {
+        InputState state = source->poll();
+        if (file.is_open()) {
+            if (runLength > 0 && state.buttons != lastButtons) {
+                flushRun();
+            }
+            lastButtons = state.buttons;
+            runLength++;
+        }
+        return state;
+    }
+
+    bool isFinished() const override { return source->isFinished(); }
+};
+
+#endif // INPUT_STATE_H
@@ -16,43 +16,30 @@ private:
     const float PUNCH_DURATION = 0.3f;
     const int PUNCH_RANGE = 1;
 
-    // Textures for different states
-    Texture standingTexture;
-    Texture runningTexture;
-    Texture ballTexture;
-    Texture currentTexture;
     bool facingRight;
     bool isBall;
 
-    bool loadTexture(Texture& texture, const string& filename) {
-        if (!texture.loadFromFile(filename)) {
-            return false;
-        }
-        return true;
-    }
-
     void updateSprite() {
-        Texture* newTexture = nullptr;
+        AnimationState state;
 
         // Check for max speed (ball form) - priority condition
         if (abs(velocityX) >= max_speed) {
-            newTexture = &ballTexture;
+            state = ANIM_BALL;
             isBall = true;
         }
         // Check for running
         else if (abs(velocityX) > 0) {
-            newTexture = &runningTexture;
+            state = ANIM_RUN;
             isBall = false;
         }
         // Standing still
         else {
-            newTexture = &standingTexture;
+            state = ANIM_STAND;
             isBall = false;
         }
 
-        // Update texture
-        currentTexture = *newTexture;
-        sprite.setTexture(currentTexture);
+        // Only the texture rect changes (see Animation.h)
+        animate(state);
 
         // Update facing direction based on velocity
         if (velocityX > 0) {
@@ -79,14 +66,10 @@ private:
 public:
     Knuckles(float start_x, float start_y, HealthManager* healthMgr, float scale = 2.5f) : Player(start_x, start_y, healthMgr, scale)
     {
-        // Load textures
-        loadTexture(standingTexture, "Data/knuckles_standing.png");
-        loadTexture(runningTexture, "Data/knuckles_running.png");
-        loadTexture(ballTexture, "Data/knuckles_ball.png");
+        // Load the animation clips (shows the standing frame)
+        animator.load("knuckles", sprite);
         
-        // Set initial texture
-        currentTexture = standingTexture;
-        sprite.setTexture(currentTexture);
+        // Set initial scale
         sprite.setScale(scale_x, scale_y);
         sprite.setOrigin(0, 0);
         
@@ -107,9 +90,9 @@ public:
         isBall = false;
     }
 
-    void handleInput(Level* level) override
+    void handleInput(Level* level, const InputState& input) override
     {
-        Player::handleInput(level);
+        Player::handleInput(level, input);
         
         // Update facing direction
         if (velocityX > 0) {
@@ -123,7 +106,7 @@ public:
             }
         }
         
-        if (Keyboard::isKeyPressed(Keyboard::LControl))
+        if (input.isDown(INPUT_ABILITY))
         {
             activateAbility(level);
         }
@@ -154,7 +137,7 @@ public:
 
     void breakWalls(Level* level) {
         int cell_size = level->getCellSize();
-        char** lvl = level->getLevelData();
+        const TileGrid& lvl = level->getTiles();
         Obstacle** obstacles = level->getObstacles();
         int obstacleCount = level->getObstacleCount();
         // Check adjacent cells in a square pattern
@@ -168,10 +151,11 @@ public:
                 // Check if within level bounds
                 if (x >= 0 && y >= 0 && x < level->getWidth() && y < level->getHeight()) {
                     // Break both breakable walls ('b') 
-                    if (lvl[y][x] == 'b') {
+                    if (lvl.hasFlag(x, y, TILE_FLAG_BREAKABLE)) {
                         // Check for breakable wall objects
                         for (int i = 0; i < obstacleCount; ++i) {
-                            BreakableWall* breakableWall = static_cast<BreakableWall*>(obstacles[i]);
+                            BreakableWall* breakableWall = dynamic_cast<BreakableWall*>(obstacles[i]);
+                            if (!breakableWall) continue;  // Spikes and other obstacles
                             float wallX = breakableWall->getX();
                             float wallY = breakableWall->getY();
                             // Check if this is the wall at the current grid position
@@ -183,7 +167,7 @@ public:
                             }
                         }
                         // Convert to empty space in the level grid
-                        lvl[y][x] = 's';
+                        level->setCell(x, y, TILE_EMPTY);
                     }
                 }
             }
@@ -0,0 +1,86 @@
+#ifndef LAYOUT_STREAM_H
+#define LAYOUT_STREAM_H
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Random access to the columns of a text layout file (one line per row, one
+// character per cell). Opening scans the file once and keeps only the byte offset
+// and length of each row, so reading any range of columns is one seek and one short
+// read per row and memory does not depend on how wide the layout is.
+// Cells past the end of a row read as 's' (empty).
+class LayoutStream {
+private:
+    ifstream file;
+    vector<streamoff> rowOffsets;
+    vector<int> rowLengths;
+    int width;
+    string rowBuffer;
+
+public:
+    LayoutStream() : width(0) {}
+
+    // Index the first maxRows rows of a layout file
+    bool open(const string& filename, int maxRows) {
+        close();
+        file.open(filename.c_str(), ios::in | ios::binary);
+        if (!file.is_open()) {
+            cout << "Failed to open level file: " << filename << endl;
+            return false;
+        }
+
+        string line;
+        streamoff offset = 0;
+        while (static_cast<int>(rowOffsets.size()) < maxRows && getline(file, line)) {
+            size_t consumed = line.size() + 1;
+            if (!line.empty() && line[line.size() - 1] == '\r') {
+                line.erase(line.size() - 1);  // Windows line endings
+            }
+            rowOffsets.push_back(offset);
+            rowLengths.push_back(static_cast<int>(line.size()));
+            if (static_cast<int>(line.size()) > width) width = static_cast<int>(line.size());
+            offset += static_cast<streamoff>(consumed);
+        }
+        file.clear();
+        return true;
+    }
+
+    void close() {
+        if (file.is_open()) file.close();
+        rowOffsets.clear();
+        rowLengths.clear();
+        width = 0;
+    }
+
+    // Read columns [firstCol, firstCol + count) of every indexed row into out,
+    // column-major (count * getRows() characters)
+    void readColumns(int firstCol, int count, vector<char>& out) {
+        int rows = getRows();
+        out.assign(static_cast<size_t>(count > 0 ? count : 0) * rows, 's');
+        if (count <= 0 || !file.is_open()) return;
+
+        for (int row = 0; row < rows; row++) {
+            int available = min(count, rowLengths[row] - firstCol);
+            if (available <= 0) continue;
+            rowBuffer.resize(available);
+            file.seekg(rowOffsets[row] + firstCol);
+            file.read(&rowBuffer[0], available);
+            int got = static_cast<int>(file.gcount());
+            for (int i = 0; i < got; i++) {
+                out[static_cast<size_t>(i) * rows + row] = rowBuffer[i];
+            }
+            file.clear();
+        }
+    }
+
+    bool isOpen() const { return file.is_open(); }
+    int getWidth() const { return width; }
+    int getRows() const { return static_cast<int>(rowOffsets.size()); }
+};
+
+#endif // LAYOUT_STREAM_H
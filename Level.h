@@ -2,8 +2,13 @@
 #define LEVEL_H
 
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <ctime>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <random>
+#include <vector>
 #include "Obstacle.h"
 #include "Spike.h"
 #include "PhysicsConfig.h"
@@ -14,111 +19,338 @@
 #include "HealthManager.h"
 #include "SpecialBoost.h"
 #include "EnemyManager.h"
-#include <SFML/Audio.hpp>
+#include "AudioManager.h"
+#include "TextureCache.h"
+#include "RenderSnapshot.h"
+#include "SpriteBatch.h"
+#include "TileMapRenderer.h"
+#include "ParallaxBackground.h"
+#include "SpatialHash.h"
+#include "CollisionBatch.h"
+#include "TileGrid.h"
+#include "LayoutStream.h"
+#include "LevelFormat.h"
+#include "MappedFile.h"
 
 using namespace sf;
 using namespace std;
 
+// The images a zone is drawn with (the table is in Levels.h)
+struct ZoneTextures {
+    const char* name;                           // For error messages
+    const char* wall;
+    const char* platform;
+    const char* breakable;
+    vector<BackgroundLayerSpec> background;     // Back to front
+};
+
 class Level {
 protected:
-    char** levelData;
+    // Item placed by the layout file, re-created on every reset
+    struct ItemSpawn {
+        TileType type;
+        int col, row;
+    };
+
+    TileGrid tiles;            // Live tiles (broken walls, collected items change it)
+    TileGrid pristineTiles;    // Tiles as loaded from the layout file
+    vector<ItemSpawn> itemSpawns;
     int width;
+    int designWidth;           // Width the zone was declared with
     int height;
     float cellSize;
     const int SCREEN_WIDTH = 1200;
     const int SCREEN_HEIGHT = 900;
-    const int BACKGROUND_WIDTH = 1600;
-    const int BACKGROUND_HEIGHT = 900;
-    static const int MAX_OBSTACLES = 256;
-    Obstacle* obstacles[MAX_OBSTACLES];
-    int obstacleCount;
-    static const int MAX_COLLECTIBLES = 256;
-    Collectible* collectibles[MAX_COLLECTIBLES];
-    int collectibleCount;
-    Texture wallTexture;
-    Texture platformTexture;
-    Sprite wallSprite;
-    Sprite platformSprite;
+    // Items live by value in one array per type (no allocation per item; the arrays
+    // keep their capacity across resets). obstacles / collectibles point into them and
+    // are rebuilt by rebuildItemIndex whenever an array changes.
+    vector<Spike> spikeStore;
+    vector<Ring> ringStore;
+    vector<ExtraLife> extraLifeStore;
+    vector<SpecialBoost> boostStore;
+    vector<Obstacle*> obstacles;
+    vector<Collectible*> collectibles;
+    TextureRegion wallTexture;
+    TextureRegion platformTexture;
+    TextureRegion breakableWallTexture;
+    TileMapRenderer tileMap;
+    ParallaxBackground background;
     PhysicsConfig physicsConfig;
     ScoreManager* scoreManager;
     HealthManager* healthManager;
     EnemyManager enemyManager;
-    Music music;
-    static Music* currentMusic;
+    SpatialHash obstacleGrid;       // Obstacles by index, filled while the level is built
+    SpatialHash collectibleGrid;    // Collectibles by index; collected ones are removed
+    vector<int> nearbyItems;        // Scratch list for grid queries
+    vector<int> visibleItems;       // Scratch list for camera-window queries
+    int culledItems;                // Items the last draw / capture skipped as off screen
+    static constexpr float CULL_MARGIN = 100.0f;    // Drawn beyond each side of the camera window
+    BoxArrays obstacleBoxes;        // Box of obstacles[i] / collectibles[i] at index i
+    BoxArrays collectibleBoxes;
+    BoxArrays candidateBoxes;       // Boxes of the grid query results, for CollisionBatch
+    vector<uint64_t> hitBits;
+    static inline unsigned int spawnSeed = 0;  // 0 = seed enemy spawns from the clock
 
-public:
-    Level(int w, int h, float cellSize, ScoreManager* scoreMgr, HealthManager* healthMgr) : width(w), height(h), cellSize(cellSize), scoreManager(scoreMgr), healthManager(healthMgr) {
-        initializeLevel();
+    // Streaming mode: layouts wider than STREAMING_MIN_COLUMNS are never loaded whole.
+    // Columns are read in chunks as they come within STREAM_AHEAD_CHUNKS of the player
+    // and dropped (tiles, items, enemies) once more than STREAM_BEHIND_CHUNKS + 1 behind,
+    // so memory stays the same however long the level is.
+    static const int STREAMING_MIN_COLUMNS = 1024;
+    static const int STREAM_CHUNK_COLUMNS = TileMapRenderer::CHUNK_COLUMNS;
+    static const int STREAM_WINDOW_COLUMNS = 128;   // Stored tile columns (>= resident chunks)
+    static const int STREAM_AHEAD_CHUNKS = 2;
+    static const int STREAM_BEHIND_CHUNKS = 2;
+    LayoutStream layoutStream;
+    bool streaming;
+    int firstChunk, lastChunk;          // Resident chunks (-1 = none yet)
+    unsigned int streamSeed;            // Enemy spawns are seeded per chunk from this
+    float enemiesPerColumn;
+    map<long long, TileType> cellOverrides;  // Cells changed in play, re-applied when their chunk reloads
+    vector<char> layoutChars;           // Scratch for layout reads
+    MappedFile levelBlob;               // Compiled level being streamed (closed otherwise)
+    const LevelBlobHeader* blobHeader;
+
+    long long cellKey(int gridX, int gridY) const {
+        return static_cast<long long>(gridX) * height + gridY;
     }
 
-    virtual ~Level() {
-        // Clean up music - ensure static pointer doesn't dangle
-        if (currentMusic == &music) {
-            music.stop();
-            currentMusic = nullptr;
+    static bool isItemTile(TileType type) {
+        return type == TILE_SPIKE || type == TILE_RING || type == TILE_EXTRA_LIFE || type == TILE_SPECIAL_BOOST;
+    }
+
+    void spawnItem(TileType type, int gridX, int gridY) {
+        switch (type) {
+            case TILE_SPIKE: addSpike(gridX, gridY); break;
+            case TILE_RING: addRing(gridX, gridY); break;
+            case TILE_EXTRA_LIFE: addExtraLife(gridX, gridY); break;
+            case TILE_SPECIAL_BOOST: addSpecialBoost(gridX, gridY); break;
+            default: break;
         }
-        
-        // Clean up level data
-        if (levelData) {
-            for (int i = 0; i < height; i++) {
-                delete[] levelData[i];
+    }
+
+    // Acquire the zone's tile images and background layers and hand them to the tile
+    // map and the background. Missing images are reported and left blank.
+    void loadZoneTextures(const ZoneTextures& zone) {
+        TextureRegion* regions[] = { &wallTexture, &platformTexture, &breakableWallTexture };
+        const char* files[] = { zone.wall, zone.platform, zone.breakable };
+        const char* kinds[] = { "wall", "platform", "breakable wall" };
+        for (int i = 0; i < 3; i++) {
+            if (!TextureCache::getInstance().acquireRegion(files[i], *regions[i])) {
+                cout << "Failed to load " << zone.name << " " << kinds[i] << " texture" << endl;
             }
-            delete[] levelData;
-        }
-        // Clean up obstacles
-        for (int i = 0; i < obstacleCount; i++) {
-            delete obstacles[i];
         }
-        obstacleCount = 0;
-        // Clean up collectibles
-        for (int i = 0; i < collectibleCount; i++) {
-            delete collectibles[i];
-        }
-        collectibleCount = 0;
+
+        tileMap.setTileTexture(TILE_WALL, wallTexture);
+        tileMap.setTileTexture(TILE_PLATFORM, platformTexture);
+        tileMap.setTileTexture(TILE_BREAKABLE, breakableWallTexture);
+        background.load(zone.background);
+    }
+
+    // Size the tile grid and the collision grids for the current width and mode
+    void resizeLevel(int newWidth) {
+        width = newWidth;
+        tiles.resize(width, height, streaming ? STREAM_WINDOW_COLUMNS : 0);
+        int gridColumns = streaming ? STREAM_WINDOW_COLUMNS : width;
+        obstacleGrid.reset(gridColumns, height, cellSize);
+        collectibleGrid.reset(gridColumns, height, cellSize);
+        enemyManager.setWorldBounds(gridColumns, height, cellSize);
+    }
+
+public:
+    Level(int w, int h, float cellSize, ScoreManager* scoreMgr, HealthManager* healthMgr) : width(w), designWidth(w), height(h), cellSize(cellSize), scoreManager(scoreMgr), healthManager(healthMgr),
+        culledItems(0), streaming(false), firstChunk(-1), lastChunk(-1), streamSeed(0), enemiesPerColumn(0.0f), blobHeader(nullptr) {
+        initializeLevel();
+    }
+
+    virtual ~Level() {
+        clearItems();
         enemyManager.clear();
     }
 
     // Pure virtual methods that must be implemented by derived classes
     virtual void createLevel() = 0;
     virtual void reset() = 0;
-    virtual void draw(RenderWindow& window, float camera_offset_x) = 0;
     virtual void loadTextures() = 0;
 
+    // Items go to the batch (drawn when GameManager flushes it); the background and
+    // tiles are drawn right away, underneath them
+    virtual void draw(RenderWindow& window, SpriteBatch& batch, float camera_offset_x) {
+        // Background layers (one quad each)
+        background.draw(window, camera_offset_x, SCREEN_WIDTH);
+
+        // Walls, platforms, and breakable walls (one batch per visible chunk)
+        tileMap.draw(window, camera_offset_x, SCREEN_WIDTH);
+
+        culledItems = 0;
+        drawObstacles(batch, camera_offset_x);
+        drawCollectibles(batch, camera_offset_x);
+    }
+
+    // What draw() shows of the world between minX and maxX, into a snapshot (enemies
+    // are captured separately, like they are drawn separately)
+    virtual void capture(RenderSnapshot& snapshot, float minX, float maxX) {
+        const vector<ParallaxLayer>& layers = background.getLayers();
+        for (size_t i = 0; i < layers.size(); i++) {
+            snapshot.addBackground(layers[i]);
+        }
+        tileMap.capture(snapshot, minX, maxX);
+        culledItems = 0;
+        captureObstacles(snapshot, minX, maxX);
+        captureCollectibles(snapshot, minX, maxX);
+    }
+
+    // Point obstacles / collectibles at the item arrays and re-index them for
+    // collision queries (collected items stay in the arrays but not in the grid)
+    void rebuildItemIndex() {
+        obstacles.clear();
+        collectibles.clear();
+        obstacleGrid.clear();
+        collectibleGrid.clear();
+        for (size_t i = 0; i < spikeStore.size(); i++) {
+            obstacles.push_back(&spikeStore[i]);
+        }
+        for (size_t i = 0; i < ringStore.size(); i++) collectibles.push_back(&ringStore[i]);
+        for (size_t i = 0; i < extraLifeStore.size(); i++) collectibles.push_back(&extraLifeStore[i]);
+        for (size_t i = 0; i < boostStore.size(); i++) collectibles.push_back(&boostStore[i]);
+
+        obstacleBoxes.clear();
+        collectibleBoxes.clear();
+        for (size_t i = 0; i < obstacles.size(); i++) {
+            obstacleBoxes.push(obstacles[i]->getX(), obstacles[i]->getY(), obstacles[i]->getWidth(), obstacles[i]->getHeight());
+            obstacleGrid.insert(static_cast<int>(i), obstacles[i]->getX(), obstacles[i]->getY(), obstacles[i]->getWidth(), obstacles[i]->getHeight());
+        }
+        for (size_t i = 0; i < collectibles.size(); i++) {
+            collectibleBoxes.push(collectibles[i]->getX(), collectibles[i]->getY(), collectibles[i]->getWidth(), collectibles[i]->getHeight());
+            if (!collectibles[i]->isCollectedState()) {
+                collectibleGrid.insert(static_cast<int>(i), collectibles[i]->getX(), collectibles[i]->getY(), collectibles[i]->getWidth(), collectibles[i]->getHeight());
+            }
+        }
+    }
+
+    // Delete all obstacles and collectibles (before the level is rebuilt)
+    void clearItems() {
+        spikeStore.clear();
+        ringStore.clear();
+        extraLifeStore.clear();
+        boostStore.clear();
+        obstacles.clear();
+        collectibles.clear();
+        obstacleBoxes.clear();
+        collectibleBoxes.clear();
+        obstacleGrid.clear();
+        collectibleGrid.clear();
+    }
+
+    // Fill visibleItems with the indices, in order, of the grid's items overlapping the
+    // columns [minX, maxX] plus CULL_MARGIN either side. Returns how many of the grid's
+    // items were left out (collected items aren't in the grid, so they don't count).
+    template <typename Item>
+    int findVisible(SpatialHash& grid, const vector<Item*>& items, float minX, float maxX) {
+        minX -= CULL_MARGIN;
+        maxX += CULL_MARGIN;
+        visibleItems.clear();
+        grid.query(minX, 0, maxX - minX, height * cellSize, visibleItems);
+        // Far apart items can share a bucket (the streaming grid wraps), so test exactly
+        size_t kept = 0;
+        for (size_t n = 0; n < visibleItems.size(); n++) {
+            const Item* item = items[visibleItems[n]];
+            if (item->getX() + item->getWidth() >= minX && item->getX() <= maxX) {
+                visibleItems[kept++] = visibleItems[n];
+            }
+        }
+        visibleItems.resize(kept);
+        sort(visibleItems.begin(), visibleItems.end());   // Draw in index order, as before
+        return grid.getItemCount() - static_cast<int>(kept);
+    }
+
+    // Boxes of the items the grid query found, in nearbyItems order
+    void gatherCandidates(const BoxArrays& boxes) {
+        candidateBoxes.clear();
+        for (size_t n = 0; n < nearbyItems.size(); n++) {
+            int i = nearbyItems[n];
+            candidateBoxes.push(boxes.x[i], boxes.y[i], boxes.w[i], boxes.h[i]);
+        }
+    }
+
+    template <typename T>
+    static void eraseOutside(vector<T>& items, float minX, float maxX) {
+        size_t kept = 0;
+        for (size_t i = 0; i < items.size(); i++) {
+            if (items[i].getX() >= minX && items[i].getX() < maxX) {
+                if (kept != i) items[kept] = items[i];
+                kept++;
+            }
+        }
+        items.erase(items.begin() + kept, items.end());
+    }
+
+    // Delete the obstacles and collectibles outside [minX, maxX); call rebuildItemIndex after
+    void removeItemsOutside(float minX, float maxX) {
+        eraseOutside(spikeStore, minX, maxX);
+        eraseOutside(ringStore, minX, maxX);
+        eraseOutside(extraLifeStore, minX, maxX);
+        eraseOutside(boostStore, minX, maxX);
+    }
+
     // Add ring to the level
+    // (collectibles are objects - their cells stay empty in the tile grid).
+    // Items added after the level is built need a rebuildItemIndex call.
     void addRing(int gridX, int gridY) {
         if (gridX >= 0 && gridX < width && gridY >= 0 && gridY < height) {
-            levelData[gridY][gridX] = 'r';  // 'r' represents ring
-            collectibles[collectibleCount++] = new Ring(gridX * cellSize, gridY * cellSize, scoreManager);
+            ringStore.push_back(Ring(gridX * cellSize, gridY * cellSize, scoreManager));
+        }
+    }
+
+    // Draw the collectibles in the camera window (collected ones are out of the grid)
+    void drawCollectibles(SpriteBatch& batch, float camera_offset_x) {
+        culledItems += findVisible(collectibleGrid, collectibles, camera_offset_x, camera_offset_x + SCREEN_WIDTH);
+        for (size_t n = 0; n < visibleItems.size(); n++) {
+            Collectible* collectible = collectibles[visibleItems[n]];
+            if (collectible->getVisible()) {
+                collectible->draw(batch, camera_offset_x);
+            }
         }
     }
 
-    // Draw collectibles
-    void drawCollectibles(RenderWindow& window, float camera_offset_x) {
-        for (int i = 0; i < collectibleCount; i++) {
-            if (collectibles[i]->getVisible()) {
-                collectibles[i]->draw(window, camera_offset_x);
+    void captureCollectibles(RenderSnapshot& snapshot, float minX, float maxX) {
+        culledItems += findVisible(collectibleGrid, collectibles, minX, maxX);
+        for (size_t n = 0; n < visibleItems.size(); n++) {
+            const Collectible* collectible = collectibles[visibleItems[n]];
+            if (collectible->getVisible()) {
+                collectible->capture(snapshot);
             }
         }
     }
 
-    // Update collectibles
-    void updateCollectibles(float deltaTime) {
-        for (int i = 0; i < collectibleCount; i++) {
-            collectibles[i]->update(deltaTime);
+    // Animate the collectibles the camera (which follows the player) can see; the
+    // others don't change until they come into view
+    void updateCollectibles(float deltaTime, float playerX) {
+        float cameraX = cameraFor(playerX);
+        findVisible(collectibleGrid, collectibles, cameraX, cameraX + SCREEN_WIDTH);
+        for (size_t n = 0; n < visibleItems.size(); n++) {
+            collectibles[visibleItems[n]]->update(deltaTime);
         }
     }
 
-    // Check collectible collisions
+    // Check collectible collisions: the grid finds the nearby items, one
+    // CollisionBatch call tests them all, and only the hits are visited
     void checkCollectibleCollisions(float playerX, float playerY, float playerWidth, float playerHeight) {
-        for (int i = 0; i < collectibleCount; i++) {
-            if (collectibles[i]->checkCollision(playerX, playerY, playerWidth, playerHeight)) {
+        nearbyItems.clear();
+        collectibleGrid.query(playerX, playerY, playerWidth, playerHeight, nearbyItems);
+        gatherCandidates(collectibleBoxes);
+        if (CollisionBatch::test(playerX, playerY, playerWidth, playerHeight, candidateBoxes, hitBits) == 0) {
+            return;
+        }
+        for (size_t n = 0; n < nearbyItems.size(); n++) {
+            int i = nearbyItems[n];
+            if (CollisionBatch::isHit(hitBits, static_cast<int>(n)) &&
+                !collectibles[i]->isCollectedState() && collectibles[i]->getVisible()) {
                 collectibles[i]->onCollect();
+                collectibleGrid.remove(i);
                 // Set the corresponding cell to empty space
                 int gridX = static_cast<int>(collectibles[i]->getX() / cellSize);
                 int gridY = static_cast<int>(collectibles[i]->getY() / cellSize);
-                if (gridX >= 0 && gridX < width && gridY >= 0 && gridY < height) {
-                    levelData[gridY][gridX] = 's';
-                }
+                setCell(gridX, gridY, TILE_EMPTY);
             }
         }
     }
@@ -129,22 +361,31 @@ public:
         int cell_y = static_cast<int>(y / cellSize);
         
         // Check if position is within bounds
-        if (cell_x < 0 || cell_x >= width || cell_y < 0 || cell_y >= height) {
+        if (!tiles.inBounds(cell_x, cell_y)) {
             return false;
         }
 
         // Check if position is in the last 10 cells of the level
-        return cell_x >= (width - 10) && levelData[cell_y][cell_x] == 's';
+        return cell_x >= (width - 10) && tiles.get(cell_x, cell_y) == TILE_EMPTY;
     }
 
     // Common methods that can be used by all levels
     void initializeLevel() {
-        // Allocate memory for level data
-        levelData = new char*[height];
-        for (int i = 0; i < height; i++) {
-            levelData[i] = new char[width];
-            for (int j = 0; j < width; j++) {
-                levelData[i][j] = 's';  // Initialize with empty space
+        resizeLevel(width);
+        pristineTiles.resize(width, height);
+    }
+
+    // Change a cell after the level is built, keeping the tile renderer in sync.
+    // A streamed level remembers the change for when the cell's chunk is reloaded.
+    void setCell(int gridX, int gridY, TileType tile) {
+        if (tiles.inBounds(gridX, gridY)) {
+            TileType old = tiles.get(gridX, gridY);
+            tiles.set(gridX, gridY, tile);
+            if (streaming) {
+                cellOverrides[cellKey(gridX, gridY)] = tile;
+            }
+            if (old != tile && (tileMap.isDrawnTile(old) || tileMap.isDrawnTile(tile))) {
+                tileMap.markDirty(gridX);
             }
         }
     }
@@ -152,69 +393,81 @@ public:
     // Add wall to the level
     void addWall(int gridX, int gridY) {
         if (gridX >= 0 && gridX < width && gridY >= 0 && gridY < height) {
-            levelData[gridY][gridX] = 'w';  // 'w' represents wall
+            tiles.set(gridX, gridY, TILE_WALL);
         }
     }
 
     // Add platform to the level
     void addPlatform(int gridX, int gridY) {
         if (gridX >= 0 && gridX < width && gridY >= 0 && gridY < height) {
-            levelData[gridY][gridX] = 'p';  // 'p' represents platform
+            tiles.set(gridX, gridY, TILE_PLATFORM);
         }
     }
 
     // Add spike to the level
     void addSpike(int gridX, int gridY) {
         if (gridX >= 0 && gridX < width && gridY >= 0 && gridY < height) {
-            levelData[gridY][gridX] = 'o';  // 'o' represents obstacle
-            obstacles[obstacleCount++] = new Spike(gridX * cellSize, gridY * cellSize, cellSize);
+            tiles.set(gridX, gridY, TILE_SPIKE);
+            spikeStore.push_back(Spike(gridX * cellSize, gridY * cellSize, cellSize));
+        }
+    }
+
+    // Draw the obstacles in the camera window
+    void drawObstacles(SpriteBatch& batch, float camera_offset_x) {
+        culledItems += findVisible(obstacleGrid, obstacles, camera_offset_x, camera_offset_x + SCREEN_WIDTH);
+        for (size_t n = 0; n < visibleItems.size(); n++) {
+            obstacles[visibleItems[n]]->draw(batch, camera_offset_x);
         }
     }
 
-    // Draw obstacles
-    void drawObstacles(RenderWindow& window, float camera_offset_x) {
-        for (int i = 0; i < obstacleCount; i++) {
-            obstacles[i]->draw(window, camera_offset_x);        
+    void captureObstacles(RenderSnapshot& snapshot, float minX, float maxX) {
+        culledItems += findVisible(obstacleGrid, obstacles, minX, maxX);
+        for (size_t n = 0; n < visibleItems.size(); n++) {
+            obstacles[visibleItems[n]]->capture(snapshot);
         }
     }
 
     // Check obstacle collisions
     bool checkObstacleCollisions(float playerX, float playerY, float playerWidth, float playerHeight) {
-        for (int i = 0; i < obstacleCount; i++) {
-            if (obstacles[i]->checkCollision(playerX, playerY, playerWidth, playerHeight)) {
-                if (static_cast<Spike*>(obstacles[i]) != nullptr) {
-                    return true;  // For spikes, return true
-                }
-                return true;  // For other obstacles, just return true
+        nearbyItems.clear();
+        obstacleGrid.query(playerX, playerY, playerWidth, playerHeight, nearbyItems);
+        gatherCandidates(obstacleBoxes);
+        if (CollisionBatch::test(playerX, playerY, playerWidth, playerHeight, candidateBoxes, hitBits) == 0) {
+            return false;
+        }
+        for (size_t n = 0; n < nearbyItems.size(); n++) {
+            if (CollisionBatch::isHit(hitBits, static_cast<int>(n)) && obstacles[nearbyItems[n]]->isSolid()) {
+                return true;
             }
         }
         return false;
     }
 
     // Getters
-    char** getLevelData() const { return levelData; }
+    const TileGrid& getTiles() const { return tiles; }
     int getWidth() const { return width; }
     int getHeight() const { return height; }
     float getCellSize() const { return cellSize; }
-    const Obstacle* const* getObstacles() const { return obstacles; }
-    Obstacle** getObstacles() { return obstacles; }
-    int getObstacleCount() const { return obstacleCount; }
-    const Collectible* const* getCollectibles() const { return collectibles; }
+    const Obstacle* const* getObstacles() const { return obstacles.data(); }
+    Obstacle** getObstacles() { return obstacles.data(); }
+    int getObstacleCount() const { return static_cast<int>(obstacles.size()); }
+    const Collectible* const* getCollectibles() const { return collectibles.data(); }
+    int getCollectibleCount() const { return static_cast<int>(collectibles.size()); }
+    bool isStreaming() const { return streaming; }
+    int getScreenWidth() const { return SCREEN_WIDTH; }
     PhysicsConfig* getPhysicsConfig() { return &physicsConfig; }
 
     // Add extra life to the level
     void addExtraLife(int gridX, int gridY) {
         if (gridX >= 0 && gridX < width && gridY >= 0 && gridY < height) {
-            levelData[gridY][gridX] = 'l';  // 'l' represents extra life
-            collectibles[collectibleCount++] = new ExtraLife(gridX * cellSize, gridY * cellSize, healthManager);
+            extraLifeStore.push_back(ExtraLife(gridX * cellSize, gridY * cellSize, healthManager));
         }
     }
 
     // Add special boost to the level
     void addSpecialBoost(int gridX, int gridY) {
         if (gridX >= 0 && gridX < width && gridY >= 0 && gridY < height) {
-            levelData[gridY][gridX] = 'z';  // 'z' represents special boost
-            collectibles[collectibleCount++] = new SpecialBoost(gridX * cellSize, gridY * cellSize);
+            boostStore.push_back(SpecialBoost(gridX * cellSize, gridY * cellSize));
         }
     }
 
@@ -224,22 +477,117 @@ public:
     void addBeeBot(int gridX, int gridY) { enemyManager.addBeeBot(gridX * cellSize, gridY * cellSize); }
     void addMotobug(int gridX, int gridY) { enemyManager.addMotobug(gridX * cellSize, gridY * cellSize); }
     void addCrabMeat(int gridX, int gridY) { enemyManager.addCrabMeat(gridX * cellSize, gridY * cellSize); }
-    void updateEnemies(float deltaTime, float playerX, float playerY) { enemyManager.updateAll(deltaTime, playerX, playerY); }
-    void drawEnemies(RenderWindow& window, float camera_offset_x) { enemyManager.drawAll(window, camera_offset_x); }
+    // Enemy shots are culled once they leave what the camera (which follows the
+    // player, see GameManager) can see, give or take a margin
+    void updateEnemies(float deltaTime, float playerX, float playerY) {
+        float cameraX = cameraFor(playerX);
+        FloatRect view(cameraX - CULL_MARGIN, -CULL_MARGIN, SCREEN_WIDTH + 2 * CULL_MARGIN, SCREEN_HEIGHT + 2 * CULL_MARGIN);
+        enemyManager.updateAll(deltaTime, playerX, playerY, view);
+    }
+    // Enemies are culled to the camera window like the items are
+    void drawEnemies(SpriteBatch& batch, float camera_offset_x, float alpha = 1.0f) {
+        enemyManager.drawVisible(batch, camera_offset_x, camera_offset_x - CULL_MARGIN, camera_offset_x + SCREEN_WIDTH + CULL_MARGIN, alpha);
+    }
+    void captureEnemies(RenderSnapshot& snapshot, float minX, float maxX) {
+        enemyManager.captureVisible(snapshot, minX - CULL_MARGIN, maxX + CULL_MARGIN);
+    }
+
+    // Where the camera is with the player at playerX (outside level transitions).
+    // GameManager places the camera with this too, so drawing and culling agree.
+    float cameraFor(float playerX) const {
+        return playerX > SCREEN_WIDTH / 2 ? playerX - SCREEN_WIDTH / 2 : 0.0f;
+    }
+
+    // Items and enemies the last draw / capture skipped for being off screen
+    int getCulledCount() const { return culledItems + enemyManager.getCulledCount(); }
+
+    // Fix the enemy spawn seed so runs (replays, headless tests) are reproducible
+    // Every image loadZoneTextures() acquires for the zone, for preloading
+    static vector<string> textureFiles(const ZoneTextures& zone) {
+        vector<string> files = { zone.wall, zone.platform, zone.breakable };
+        for (size_t i = 0; i < zone.background.size(); i++) {
+            if (find(files.begin(), files.end(), zone.background[i].file) == files.end()) {
+                files.push_back(zone.background[i].file);
+            }
+        }
+        return files;
+    }
+
+    static void setSpawnSeed(unsigned int seed) { spawnSeed = seed; }
+    static unsigned int getSpawnSeed() { return spawnSeed; }
+
+    // Load a different layout file (text, or .lvb from tools/LevelCompiler.cpp) into
+    // this zone and restart it
+    bool loadLayout(const string& filename) {
+        bool compiled = filename.size() > 4 && filename.compare(filename.size() - 4, 4, ".lvb") == 0;
+        bool loaded = compiled ? loadCompiledLevel(filename.c_str()) : loadLayoutFromFile(filename.c_str());
+        reset();
+        return loaded;
+    }
+
+    // Load and drop chunks of a streamed level around focusX (the player);
+    // does nothing for a fully loaded level
+    void updateStreaming(float focusX) {
+        if (!streaming) return;
+        int chunkCount = (width + STREAM_CHUNK_COLUMNS - 1) / STREAM_CHUNK_COLUMNS;
+        int focus = static_cast<int>(max(0.0f, focusX) / (cellSize * STREAM_CHUNK_COLUMNS));
+        focus = min(focus, chunkCount - 1);
+        int wantFirst = max(0, focus - STREAM_BEHIND_CHUNKS);
+        int wantLast = min(chunkCount - 1, focus + STREAM_AHEAD_CHUNKS);
+
+        int first = wantFirst;
+        int last = wantLast;
+        if (firstChunk >= 0 && wantFirst <= lastChunk && wantLast >= firstChunk) {
+            // Keep one chunk of slack on each side so pacing over a boundary doesn't reload
+            first = min(wantFirst, max(firstChunk, wantFirst - 1));
+            last = max(wantLast, min(lastChunk, wantLast + 1));
+        }
+        if (first == firstChunk && last == lastChunk) return;
+
+        int oldFirst = firstChunk;
+        int oldLast = lastChunk;
+        firstChunk = first;
+        lastChunk = last;
+        tiles.setResidentColumns(first * STREAM_CHUNK_COLUMNS, min(width, (last + 1) * STREAM_CHUNK_COLUMNS) - 1);
+
+        float minX = first * STREAM_CHUNK_COLUMNS * cellSize;
+        float maxX = (last + 1) * STREAM_CHUNK_COLUMNS * cellSize;
+        removeItemsOutside(minX, maxX);
+        enemyManager.removeSpawnedOutside(minX, maxX);
+
+        for (int chunk = first; chunk <= last; chunk++) {
+            if (oldFirst < 0 || chunk < oldFirst || chunk > oldLast) {
+                loadChunk(chunk);
+            }
+        }
+        rebuildItemIndex();
+    }
 
 	//Spawn random enemies
     void spawnRandomEnemies(int count) {
-        srand(static_cast<unsigned>(time(nullptr)));
+        if (streaming) {
+            // Same density as the zone's designed length, placed chunk by chunk as they load
+            enemiesPerColumn = designWidth > 0 ? static_cast<float>(count) / designWidth : 0.0f;
+            return;
+        }
+        // mt19937 produces the same sequence on every platform, unlike rand()
+        mt19937 rng(spawnSeed ? spawnSeed : static_cast<unsigned>(time(nullptr)));
+        spawnEnemiesInColumns(rng, count, 0, width);
+    }
+
+    // Place up to count enemies on free cells of columns [firstCol, firstCol + columns)
+    void spawnEnemiesInColumns(mt19937& rng, int count, int firstCol, int columns) {
         int attempts = 0;
         int spawned = 0;
         while (spawned < count && attempts < count * 10) { 
-            int gx = rand() % width;
-            int gy = rand() % (height - 1); 
-            if (levelData[gy][gx] == 's') {
-                int type = rand() % 4;
+            int gx = firstCol + rng() % columns;
+            int gy = rng() % (height - 1); 
+            if (tiles.get(gx, gy) == TILE_EMPTY) {
+                int type = rng() % 4;
                 bool canSpawn = true;
                 if (type == 2 || type == 3) { 
-                    if (gy + 1 >= height || !(levelData[gy + 1][gx] == 'w' || levelData[gy + 1][gx] == 'p')) {
+                    TileType below = tiles.get(gx, gy + 1);
+                    if (gy + 1 >= height || !(below == TILE_WALL || below == TILE_PLATFORM)) {
                         canSpawn = false;
                     }
                 }
@@ -259,87 +607,219 @@ public:
 
 	// Check for enemy collisions
     bool checkEnemyCollisions(float playerX, float playerY, float playerWidth, float playerHeight) {
+        return enemyManager.collidesWith(playerX, playerY, playerWidth, playerHeight);
+    }
 
-        for (int i = 0; i < enemyManager.getEnemyCount(); ++i) {
-            Enemy* enemy = enemyManager.getEnemy(i);
-            if (enemy && enemy->getIsAlive()) {
-                float ex, ey, ew, eh;
-                enemy->getPosition(ex, ey);
-                enemy->getSize(ew, eh);
-                if (checkCollision(playerX, playerY, playerWidth, playerHeight, ex, ey, ew, eh)) {
-                    return true;
-                }
-                // Use dynamic_cast to properly check enemy types
-                BeeBot* bee = dynamic_cast<BeeBot*>(enemy);
-                if (bee) {
-                    for (int j = 0; j < 2; ++j) {  // BeeBot::MAX_PROJECTILES is 2
-                        const Projectile& p = bee->getProjectile(j);
-                        if (p.active && checkCollision(playerX, playerY, playerWidth, playerHeight, p.x, p.y, Projectile::SIZE, Projectile::SIZE)) {
-                            return true;
-                        }
-                    }
+    // Zone background music is the only streamed audio
+    void loadMusic(const string& filename) {
+        AudioManager::getInstance().playMusic(filename);
+    }
+
+    void stopMusic() {
+        AudioManager::getInstance().stopMusic();
+    }
+
+protected:
+    // Read a layout file. Layouts up to STREAMING_MIN_COLUMNS wide are read whole into
+    // the pristine tile grid and the item spawn list, once per level; resets restore
+    // from these without touching the disk. Wider layouts switch the level to streaming
+    // mode and are read a chunk at a time by updateStreaming.
+    // A layout wider than the zone's declared width widens the level.
+    bool loadLayoutFromFile(const char* filename) {
+        startLoading();
+
+        if (!layoutStream.open(filename, height)) {
+            streaming = false;
+            resizeLevel(designWidth);
+            pristineTiles.resize(width, height);
+            return false;
+        }
+        streaming = layoutStream.getWidth() > STREAMING_MIN_COLUMNS;
+        resizeLevel(max(designWidth, layoutStream.getWidth()));
+        if (streaming) {
+            pristineTiles.resize(0, 0);
+            return true;
+        }
+
+        pristineTiles.resize(width, height);
+        int rows = layoutStream.getRows();
+        layoutStream.readColumns(0, width, layoutChars);
+        layoutStream.close();
+        for (int row = 0; row < rows; row++) {
+            for (int col = 0; col < width; col++) {
+                TileType type = TileGrid::fromChar(layoutChars[static_cast<size_t>(col) * rows + row]);
+                if (isItemTile(type)) {
+                    ItemSpawn spawn = { type, col, row };
+                    itemSpawns.push_back(spawn);
                 }
-                CrabMeat* crab = dynamic_cast<CrabMeat*>(enemy);
-                if (crab) {
-                    for (int j = 0; j < 4; ++j) {
-                        const CrabMeat::Projectile& p = crab->getProjectile(j);
-                        if (p.active && checkCollision(playerX, playerY, playerWidth, playerHeight, p.x, p.y, 10.0f, 6.0f)) {
-                            return true;
-                        }
-                    }
+                else {
+                    pristineTiles.set(col, row, type);
                 }
             }
         }
-        return false;
+        return true;
     }
 
-    void loadMusic(const string& filename) {
-        if (currentMusic && currentMusic->getStatus() == Music::Playing) {
-            currentMusic->stop();
+    // Forget the current layout before loading another
+    void startLoading() {
+        clearItems();
+        itemSpawns.clear();
+        cellOverrides.clear();
+        firstChunk = lastChunk = -1;
+        levelBlob.close();
+        blobHeader = nullptr;
+        layoutStream.close();
+    }
+
+    // Load a level compiled by tools/LevelCompiler.cpp. The file is memory-mapped and
+    // validated (magic, version, section sizes, checksum); tiles are copied straight
+    // from its tile section and items from its entity table, and the zone takes the
+    // physics stored in it. A level wider than STREAMING_MIN_COLUMNS keeps the file
+    // mapped and streams from it. Returns false (loading nothing) if the file is
+    // missing or invalid.
+    bool loadCompiledLevel(const char* filename) {
+        startLoading();
+        if (!levelBlob.open(filename)) {
+            return false;
+        }
+        const char* error = "";
+        const LevelBlobHeader* header = validateLevelBlob(levelBlob.data(), levelBlob.size(), error);
+        if (!header) {
+            cout << "Ignoring compiled level " << filename << ": " << error << endl;
+            levelBlob.close();
+            return false;
         }
-        if (music.openFromFile(filename)) {
-            music.setLoop(true);
-            music.play();
-            currentMusic = &music;
+
+        physicsConfig = PhysicsConfig::fromArray(header->physics);
+        int blobWidth = static_cast<int>(header->width);
+        streaming = blobWidth > STREAMING_MIN_COLUMNS;
+        resizeLevel(max(designWidth, blobWidth));
+        if (streaming) {
+            blobHeader = header;
+            pristineTiles.resize(0, 0);
+            return true;
+        }
+
+        pristineTiles.resize(width, height);
+        int blobRows = static_cast<int>(header->height);
+        int rows = min(height, blobRows);
+        const unsigned char* tileSection = levelBlob.data() + header->tileOffset;
+        for (int col = 0; col < blobWidth; col++) {
+            const unsigned char* column = tileSection + static_cast<size_t>(col) * blobRows;
+            for (int row = 0; row < rows; row++) {
+                pristineTiles.set(col, row, static_cast<TileType>(column[row]));
+            }
+        }
+        const LevelBlobEntity* entities = reinterpret_cast<const LevelBlobEntity*>(levelBlob.data() + header->entityOffset);
+        itemSpawns.reserve(header->entityCount);
+        for (uint32_t i = 0; i < header->entityCount; i++) {
+            ItemSpawn spawn = { static_cast<TileType>(entities[i].type), static_cast<int>(entities[i].col), entities[i].row };
+            itemSpawns.push_back(spawn);
         }
+        levelBlob.close();
+        return true;
     }
 
-    void stopMusic() {
-        music.stop();
+    // Put the level back to its loaded layout: the tiles are one bulk copy of the
+    // pristine grid, obstacles and collectibles are re-created from the spawn list.
+    // A streamed level instead forgets everything loaded and changed; the next
+    // updateStreaming call loads the chunks around the player again.
+    void restoreLayout() {
+        clearItems();
+        if (streaming) {
+            cellOverrides.clear();
+            firstChunk = lastChunk = -1;
+            tiles.setResidentColumns(0, -1);
+            streamSeed = spawnSeed ? spawnSeed : static_cast<unsigned>(time(nullptr));
+            tileMap.build(&tiles, cellSize);
+            return;
+        }
+        tiles = pristineTiles;
+        int counts[TILE_TYPE_COUNT] = {};
+        for (size_t i = 0; i < itemSpawns.size(); i++) {
+            counts[itemSpawns[i].type]++;
+        }
+        spikeStore.reserve(counts[TILE_SPIKE]);
+        ringStore.reserve(counts[TILE_RING]);
+        extraLifeStore.reserve(counts[TILE_EXTRA_LIFE]);
+        boostStore.reserve(counts[TILE_SPECIAL_BOOST]);
+        for (size_t i = 0; i < itemSpawns.size(); i++) {
+            spawnItem(itemSpawns[i].type, itemSpawns[i].col, itemSpawns[i].row);
+        }
+        rebuildItemIndex();
+        tileMap.build(&tiles, cellSize);
     }
 
-protected:
-    bool loadLayoutFromFile(const char* filename) {
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            std::cout << "Failed to open level file: " << filename << std::endl;
-            return false;
+    // Place one cell of a streamed chunk, unless a change made in play overrides it
+    void placeStreamedCell(int col, int row, TileType type) {
+        map<long long, TileType>::const_iterator changed = cellOverrides.find(cellKey(col, row));
+        if (changed != cellOverrides.end()) {
+            tiles.set(col, row, changed->second);
+        }
+        else if (isItemTile(type)) {
+            spawnItem(type, col, row);
+        }
+        else {
+            tiles.set(col, row, type);
+        }
+    }
+
+    // Read one chunk of a streamed layout (compiled or text) into the tile window and
+    // create its items (minus those already collected) and enemies.
+    // Call rebuildItemIndex once the chunks of an update are loaded.
+    void loadChunk(int chunk) {
+        int firstCol = chunk * STREAM_CHUNK_COLUMNS;
+        int count = width - firstCol;
+        if (count > STREAM_CHUNK_COLUMNS) count = STREAM_CHUNK_COLUMNS;
+
+        if (blobHeader) {
+            int blobRows = static_cast<int>(blobHeader->height);
+            int blobWidth = static_cast<int>(blobHeader->width);
+            int rows = min(height, blobRows);
+            const unsigned char* tileSection = levelBlob.data() + blobHeader->tileOffset;
+            for (int col = firstCol; col < firstCol + count; col++) {
+                tiles.clearColumn(col);
+                if (col >= blobWidth) continue;
+                const unsigned char* column = tileSection + static_cast<size_t>(col) * blobRows;
+                for (int row = 0; row < rows; row++) {
+                    placeStreamedCell(col, row, static_cast<TileType>(column[row]));
+                }
+            }
+            // Entities are sorted by column: binary search to the chunk's first one
+            const LevelBlobEntity* begin = reinterpret_cast<const LevelBlobEntity*>(levelBlob.data() + blobHeader->entityOffset);
+            const LevelBlobEntity* end = begin + blobHeader->entityCount;
+            LevelBlobEntity key = { static_cast<uint32_t>(firstCol), 0, 0 };
+            const LevelBlobEntity* entity = lower_bound(begin, end, key,
+                [](const LevelBlobEntity& a, const LevelBlobEntity& b) { return a.col < b.col; });
+            for (; entity != end && static_cast<int>(entity->col) < firstCol + count; ++entity) {
+                if (entity->row < height) {
+                    placeStreamedCell(static_cast<int>(entity->col), entity->row, static_cast<TileType>(entity->type));
+                }
+            }
         }
-        char line[256];
-        int row = 0;
-        while (file.getline(line, sizeof(line)) && row < height) {
-            for (int col = 0; col < width && line[col] != '\0'; ++col) {
-                char c = line[col];
-                switch (c) {
-                    case 'w': addWall(col, row); break;
-                    case 'p': addPlatform(col, row); break;
-                    case 'b': levelData[row][col] = 'b'; break;
-                    case 'o': addSpike(col, row); break;
-                    case 'r': addRing(col, row); levelData[row][col] = 's'; break;
-                    case 'l': addExtraLife(col, row); levelData[row][col] = 's'; break;
-                    case 'z': addSpecialBoost(col, row); levelData[row][col] = 's'; break;
-                    // 's' is space, do nothing
-                    default: levelData[row][col] = c; break;
+        else {
+            int rows = min(height, layoutStream.getRows());
+            layoutStream.readColumns(firstCol, count, layoutChars);
+            for (int i = 0; i < count; i++) {
+                int col = firstCol + i;
+                tiles.clearColumn(col);
+                for (int row = 0; row < rows; row++) {
+                    placeStreamedCell(col, row, TileGrid::fromChar(layoutChars[static_cast<size_t>(i) * layoutStream.getRows() + row]));
                 }
             }
-            row++;
         }
-        file.close();
-        return true;
+        tileMap.markDirty(firstCol);
+
+        // Enemy placement depends only on the seed and the chunk, so a chunk that
+        // streams in again gets the same enemies back
+        float expected = enemiesPerColumn * count;
+        mt19937 rng(streamSeed ^ (static_cast<unsigned>(chunk) * 2654435761u));
+        int enemies = static_cast<int>(expected);
+        if ((rng() % 1000) < static_cast<unsigned>((expected - enemies) * 1000)) enemies++;
+        if (enemies > 0) {
+            spawnEnemiesInColumns(rng, enemies, firstCol, count);
+        }
     }
 };
 
-// Initialize static member
-Music* Level::currentMusic = nullptr;
-
 #endif 
\ No newline at end of file
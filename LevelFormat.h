@@ -0,0 +1,102 @@
+#ifndef LEVEL_FORMAT_H
+#define LEVEL_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "TileGrid.h"
+
+using namespace std;
+
+// Compiled level files (.lvb), written by tools/LevelCompiler.cpp and memory-mapped by
+// Level::loadCompiledLevel. All fields are little-endian; sections are 4-byte aligned.
+//
+//   LevelBlobHeader
+//   tile section    width * height bytes, column-major TileType values
+//                   (item cells are TILE_EMPTY - items are in the entity table)
+//   entity table    entityCount LevelBlobEntity records, sorted by column then row
+//
+// The checksum covers everything after the header. Bump LEVEL_BLOB_VERSION whenever
+// the layout of any of these changes; old files are then rejected and the game falls
+// back to the text layouts until they are recompiled.
+static const char LEVEL_BLOB_MAGIC[4] = { 'S', 'L', 'V', 'B' };
+static const uint32_t LEVEL_BLOB_VERSION = 1;
+
+struct LevelBlobHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t width;           // Columns
+    uint32_t height;          // Rows
+    float physics[8];         // PhysicsConfig, in constructor argument order
+    uint32_t tileOffset;      // From the start of the file
+    uint32_t entityOffset;
+    uint32_t entityCount;
+    uint32_t checksum;        // FNV-1a of every byte after the header
+};
+
+// An item placed by the layout (TILE_SPIKE, TILE_RING, TILE_EXTRA_LIFE or TILE_SPECIAL_BOOST)
+struct LevelBlobEntity {
+    uint32_t col;
+    uint16_t row;
+    uint16_t type;
+};
+
+static_assert(sizeof(LevelBlobHeader) == 64, "LevelBlobHeader must stay 64 bytes");
+static_assert(sizeof(LevelBlobEntity) == 8, "LevelBlobEntity must stay 8 bytes");
+
+inline uint32_t levelBlobChecksum(const unsigned char* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Check that a mapped file is a complete, intact level blob of this version.
+// Returns the header, or nullptr (with the reason in 'error') if it is not.
+inline const LevelBlobHeader* validateLevelBlob(const unsigned char* data, size_t size, const char*& error) {
+    if (!data || size < sizeof(LevelBlobHeader)) {
+        error = "file too small";
+        return nullptr;
+    }
+    const LevelBlobHeader* header = reinterpret_cast<const LevelBlobHeader*>(data);
+    if (memcmp(header->magic, LEVEL_BLOB_MAGIC, sizeof(LEVEL_BLOB_MAGIC)) != 0) {
+        error = "not a level blob";
+        return nullptr;
+    }
+    if (header->version != LEVEL_BLOB_VERSION) {
+        error = "wrong version (recompile it)";
+        return nullptr;
+    }
+
+    uint64_t tileBytes = static_cast<uint64_t>(header->width) * header->height;
+    uint64_t entityBytes = static_cast<uint64_t>(header->entityCount) * sizeof(LevelBlobEntity);
+    if (header->width == 0 || header->height == 0 ||
+        header->tileOffset < sizeof(LevelBlobHeader) || header->tileOffset + tileBytes > size ||
+        header->entityOffset % 4 != 0 || header->entityOffset < header->tileOffset + tileBytes ||
+        header->entityOffset + entityBytes > size) {
+        error = "bad section sizes";
+        return nullptr;
+    }
+    if (levelBlobChecksum(data + sizeof(LevelBlobHeader), size - sizeof(LevelBlobHeader)) != header->checksum) {
+        error = "checksum mismatch";
+        return nullptr;
+    }
+
+    const LevelBlobEntity* entities = reinterpret_cast<const LevelBlobEntity*>(data + header->entityOffset);
+    for (uint32_t i = 0; i < header->entityCount; i++) {
+        const LevelBlobEntity& entity = entities[i];
+        bool sorted = i == 0 || entities[i - 1].col < entity.col ||
+            (entities[i - 1].col == entity.col && entities[i - 1].row < entity.row);
+        if (entity.col >= header->width || entity.row >= header->height || !sorted ||
+            (entity.type != TILE_SPIKE && entity.type != TILE_RING &&
+             entity.type != TILE_EXTRA_LIFE && entity.type != TILE_SPECIAL_BOOST)) {
+            error = "bad entity table";
+            return nullptr;
+        }
+    }
+    return header;
+}
+
+#endif // LEVEL_FORMAT_H
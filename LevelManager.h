@@ -4,32 +4,163 @@
 #include <SFML/Graphics.hpp>
 #include "Levels.h"
 #include "PlayerManager.h"
+#include "Trace.h"
+#include "ZoneLoader.h"
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
 
 using namespace sf;
 using namespace std;
 
+// Zones are built when first needed. Near the end of a zone (or once its exit is
+// reached) the next one is preloaded: ZoneLoader decodes its images in the background,
+// pumpPreload uploads them a slice per frame and then builds the zone, so neither
+// startup nor a transition waits on the disk. A zone left behind is released.
+//
+// The simulation only asks for zones; pumpPreload runs where the GL context is (the
+// main thread) and hands each built zone back, which the simulation picks up on its
+// next request or transition. In threaded mode that is another thread than the ticks.
 class LevelManager {
 private:
-    Level* levels[3];  
+    Level* levels[3];  // nullptr until built
     int currentLevelIndex;
     const float CELL_SIZE = 64.0f;
     const float START_X = 100.0f; 
     const float START_Y = 100.0f;
     
     // Transition system
-    Clock transitionClock;
+    float transitionTimer;  // Seconds since the transition started
     const float TRANSITION_DELAY = 1.0f;  
     bool isTransitioning;
     int nextLevelIndex;
     PlayerManager* playerManager; 
+    ScoreManager* scoreManager;
+    HealthManager* healthManager;
+
+    // Preloading
+    ZoneLoader loader;
+    int preloadIndex;       // pumpPreload's side: zone being loaded, -1 if none
+    int pendingIndex;       // Simulation side: zone asked for and not taken yet, -1 if none
+    bool threadedLoading;   // pumpPreload runs on another thread than the simulation
+    mutex handoverLock;
+    condition_variable zoneBuilt;
+    int requestedIndex;     // Guarded: asked for, not picked up by pumpPreload yet
+    Level* builtZone;       // Guarded: the pending zone, built and waiting to be taken
+    bool loadingStopped;    // Guarded: pumpPreload won't run again, don't wait for it
+    const float PRELOAD_DISTANCE = 2560.0f;  // Start this close (px) to the end of a zone
+    const float PRELOAD_BUDGET_MS = 2.0f;    // Main thread time per frame for uploads
+
+    Level* createZone(int index) {
+        switch (index) {
+        case 0: {
+            TRACE_SCOPE("load", "LabyrinthZone");
+            return new LabyrinthZone(scoreManager, healthManager);
+        }
+        case 1: {
+            TRACE_SCOPE("load", "IceCapZone");
+            return new IceCapZone(scoreManager, healthManager);
+        }
+        default: {
+            TRACE_SCOPE("load", "DeathEggZone");
+            return new DeathEggZone(scoreManager, healthManager);
+        }
+        }
+    }
+
+    static vector<string> zoneTextureFiles(int index) {
+        return Level::textureFiles(zoneTextures(index));
+    }
+
+    // Simulation side: take the pending zone if pumpPreload has built it
+    void takeBuiltZone() {
+        if (pendingIndex < 0) return;
+        Level* zone;
+        {
+            lock_guard<mutex> guard(handoverLock);
+            zone = builtZone;
+            builtZone = nullptr;
+        }
+        if (zone) {
+            levels[pendingIndex] = zone;
+            pendingIndex = -1;
+        }
+    }
+
+    // Threaded mode: wait for the render thread to build the pending zone. Returns
+    // false if it stopped loading first (the game is closing).
+    bool waitForBuiltZone() {
+        TRACE_SCOPE("load", "wait for zone");
+        {
+            unique_lock<mutex> guard(handoverLock);
+            zoneBuilt.wait(guard, [this] { return builtZone != nullptr || loadingStopped; });
+        }
+        takeBuiltZone();
+        return pendingIndex < 0;
+    }
+
+    // Single-threaded: build a zone right here, finishing its preload first if one is
+    // under way
+    void buildNow(int index) {
+        if (pendingIndex == index) {
+            pendingIndex = -1;
+            lock_guard<mutex> guard(handoverLock);
+            if (requestedIndex == index) {
+                requestedIndex = -1;
+            }
+        }
+        loader.finish(index);
+        levels[index] = createZone(index);
+        loader.release(index);
+        if (preloadIndex == index) {
+            preloadIndex = -1;
+        }
+    }
+
+    // Make sure a zone is built before switching to it. In threaded mode the
+    // simulation waits for the render thread rather than touching textures itself.
+    bool ensureLevel(int index) {
+        takeBuiltZone();
+        if (levels[index]) return true;
+        if (!threadedLoading) {
+            buildNow(index);
+            return true;
+        }
+        if (pendingIndex != index) {
+            if (pendingIndex >= 0 && !waitForBuiltZone()) return false;
+            requestPreload(index);
+        }
+        return waitForBuiltZone();
+    }
+
+    void releaseLevel(int index) {
+        if (index == currentLevelIndex) return;
+        delete levels[index];
+        levels[index] = nullptr;
+    }
+
+    // Simulation side: ask pumpPreload for a zone (one at a time)
+    void requestPreload(int index) {
+        takeBuiltZone();
+        if (index < 0 || index >= 3 || levels[index] || pendingIndex >= 0) return;
+        TRACE_INSTANT("load", "preload requested");
+        pendingIndex = index;
+        lock_guard<mutex> guard(handoverLock);
+        requestedIndex = index;
+    }
 
 public:
-    LevelManager(PlayerManager* pm, ScoreManager* scoreMgr, HealthManager* healthMgr) : currentLevelIndex(0), isTransitioning(false), nextLevelIndex(-1), playerManager(pm) {
-        // Initialize levels
-        levels[0] = new LabyrinthZone(scoreMgr, healthMgr);
-        levels[1] = new IceCapZone(scoreMgr, healthMgr);
-        levels[2] = new DeathEggZone(scoreMgr, healthMgr);
+    LevelManager(PlayerManager* pm, ScoreManager* scoreMgr, HealthManager* healthMgr, int startLevelIndex = 0)
+        : currentLevelIndex(startLevelIndex >= 0 && startLevelIndex < 3 ? startLevelIndex : 0),
+          transitionTimer(0.0f), isTransitioning(false), nextLevelIndex(-1), playerManager(pm),
+          scoreManager(scoreMgr), healthManager(healthMgr), preloadIndex(-1), pendingIndex(-1),
+          threadedLoading(false), requestedIndex(-1), builtZone(nullptr), loadingStopped(false) {
+        // Only the starting zone is built up front
+        for (int i = 0; i < 3; i++) {
+            levels[i] = nullptr;
+        }
+        ensureLevel(currentLevelIndex);
+        TextureCache::getInstance().printStats();
     }
 
     // Clean up levels
@@ -37,6 +168,7 @@ public:
         for (int i = 0; i < 3; i++) {
             delete levels[i];
         }
+        delete builtZone;
     }
 
     Level* getCurrentLevel() const {
@@ -45,22 +177,22 @@ public:
 
     void nextLevel() {
         if (currentLevelIndex < 2) {  
-            currentLevelIndex++;
-            levels[currentLevelIndex]->reset();
+            setLevel(currentLevelIndex + 1);
         }
     }
 
     void previousLevel() {
         if (currentLevelIndex > 0) {
-            currentLevelIndex--;
-            levels[currentLevelIndex]->reset();
+            setLevel(currentLevelIndex - 1);
         }
     }
 
     void setLevel(int index) {
-        if (index >= 0 && index < 3) {
+        if (index >= 0 && index < 3 && ensureLevel(index)) {
+            int previousIndex = currentLevelIndex;
             currentLevelIndex = index;
             levels[currentLevelIndex]->reset();
+            releaseLevel(previousIndex);
         }
     }
 
@@ -69,8 +201,12 @@ public:
     }
 
     // Common level functions
-    void drawLevel(RenderWindow& window, float camera_offset_x) {
-        levels[currentLevelIndex]->draw(window, camera_offset_x);
+    void drawLevel(RenderWindow& window, SpriteBatch& batch, float camera_offset_x) {
+        levels[currentLevelIndex]->draw(window, batch, camera_offset_x);
+    }
+
+    void captureLevel(RenderSnapshot& snapshot, float minX, float maxX) {
+        levels[currentLevelIndex]->capture(snapshot, minX, maxX);
     }
 
     void resetLevel() {
@@ -82,18 +218,21 @@ public:
         if (player->needsLevelTransition() && !isTransitioning) {
             isTransitioning = true;
             nextLevelIndex = currentLevelIndex + 1;
-            transitionClock.restart();
+            transitionTimer = 0.0f;
             player->resetLevelTransition();
+            TRACE_INSTANT("level", "transition started");
+            requestPreload(nextLevelIndex);
         }
     }
 
     // Update transition state
     bool updateTransition(Player* player) {
         if (isTransitioning) {
-            if (transitionClock.getElapsedTime().asSeconds() >= TRANSITION_DELAY) {
+            transitionTimer += SIM_DT;
+            if (transitionTimer >= TRANSITION_DELAY) {
+                TRACE_SCOPE("level", "LevelManager::updateTransition");
                 if (nextLevelIndex < 3) {
-                    currentLevelIndex = nextLevelIndex;
-                    levels[currentLevelIndex]->reset();
+                    setLevel(nextLevelIndex);
                     cout << "[DEBUG] Transitioned to level " << (currentLevelIndex + 1) << endl;
                     playerManager->resetAllPlayers(START_X, START_Y);
                 }
@@ -109,16 +248,64 @@ public:
         return isTransitioning;
     }
 
+    // Start preloading the next zone once the player nears the end of this one
+    void preloadAhead(float playerX) {
+        Level* level = levels[currentLevelIndex];
+        if (playerX > level->getWidth() * level->getCellSize() - PRELOAD_DISTANCE) {
+            requestPreload(currentLevelIndex + 1);
+        }
+    }
+
+    // Main thread, once per frame: pick up a requested zone, upload a slice of its
+    // textures and, once they are all in, build it and hand it to the simulation
+    void pumpPreload() {
+        if (preloadIndex < 0) {
+            {
+                lock_guard<mutex> guard(handoverLock);
+                preloadIndex = requestedIndex;
+                requestedIndex = -1;
+            }
+            if (preloadIndex < 0) return;
+            loader.request(preloadIndex, zoneTextureFiles(preloadIndex));
+        }
+        if (!loader.pump(preloadIndex, PRELOAD_BUDGET_MS)) return;
+
+        Level* zone = createZone(preloadIndex);
+        loader.release(preloadIndex);
+        preloadIndex = -1;
+        {
+            lock_guard<mutex> guard(handoverLock);
+            builtZone = zone;
+        }
+        zoneBuilt.notify_all();
+    }
+
+    // Threaded mode: set before the simulation thread starts
+    void setThreadedLoading(bool value) { threadedLoading = value; }
+
+    // Threaded mode: the render thread is done, so a simulation waiting for a zone gives up
+    void stopLoading() {
+        {
+            lock_guard<mutex> guard(handoverLock);
+            loadingStopped = true;
+        }
+        zoneBuilt.notify_all();
+    }
+
+    bool isPreloading() const { return pendingIndex >= 0; }
+
+    // nullptr for a zone that isn't built
+    Level* getLevel(int idx) const {
+        return (idx >= 0 && idx < 3) ? levels[idx] : nullptr;
+    }
+
     void getStartPosition(float& x, float& y) const {
         x = START_X;
         y = START_Y;
     }
 
     void setCurrentLevelIndex(int idx) {
-        if (idx >= 0 && idx < 3) {
-            currentLevelIndex = idx;
-            levels[currentLevelIndex]->reset();
-        }
+        setLevel(idx);
     }
 };
 
@@ -8,412 +8,116 @@
 using namespace sf;
 using namespace std;
 
-class LabyrinthZone : public Level {
-private:
-    Texture labyrinthBackgroundTexture;
-    Sprite labyrinthBackgroundSprite;
-    Texture breakableWallTexture;
-    Sprite breakableWallSprite;
+// Each zone's images, by zone index. Background layers go back to front: an image,
+// its scroll factor (1 moves with the level, 0 stays put), the size one repeat is
+// stretched to, and its top edge. Death Egg splits its backdrop into two bands, the
+// upper one further away.
+inline const ZoneTextures& zoneTextures(int index) {
+    static const ZoneTextures zones[] = {
+        { "labyrinth", "Data/brick2.png", "Data/wall.png", "Data/brick3.png",
+          { { "Data/background.png", 0.5f, 1600, 900, 0 } } },
+        { "ice", "Data/ice_wall.png", "Data/ice_platform.png", "Data/ice_breakable_wall.png",
+          { { "Data/ice_background.png", 0.5f, 1600, 900, 0 } } },
+        { "death egg", "Data/deathegg_brick.png", "Data/deathegg_platform.png", "Data/death_breakable_wall.png",
+          { { "Data/deathegg_background.png", 0.25f, 400, 450, 0 },
+            { "Data/deathegg_background.png", 0.5f, 400, 450, 450 } } }
+    };
+    return zones[index];
+}
 
+class LabyrinthZone : public Level {
 public:
+    static const int INDEX = 0;
+
     LabyrinthZone(ScoreManager* scoreMgr, HealthManager* healthMgr) : Level(200, 14, 64.0f, scoreMgr, healthMgr) {
-        // Normal/balanced physics - good acceleration, responsive controls
-        physicsConfig = PhysicsConfig(0.45f, 15.0f, 0.92f, 0.2f, 0.65f, 18.0f, -18.0f, 0.6f);
+        physicsConfig = PhysicsConfig::labyrinthZone();
         loadTextures();
         createLevel();
     }
 
     void loadTextures() override {
-        // Load level-specific textures
-        if (!wallTexture.loadFromFile("Data/brick2.png")) {
-            cout << "Failed to load labyrinth wall texture" << endl;
-        }
-        if (!platformTexture.loadFromFile("Data/wall.png")) {
-            cout << "Failed to load labyrinth platform texture" << endl;
-        }
-        if (!labyrinthBackgroundTexture.loadFromFile("Data/background.png")) {
-            cout << "Failed to load labyrinth background texture" << endl;
-        }
-        if (!breakableWallTexture.loadFromFile("Data/brick3.png")) {
-            cout << "Failed to load labyrinth breakable wall texture" << endl;
-        }
-
-        wallSprite.setTexture(wallTexture);
-        platformSprite.setTexture(platformTexture);
-        labyrinthBackgroundSprite.setTexture(labyrinthBackgroundTexture);
-        breakableWallSprite.setTexture(breakableWallTexture);
-
-        // Set sprite scales to match cell size
-        wallSprite.setScale(
-            static_cast<float>(cellSize) / wallTexture.getSize().x,
-            static_cast<float>(cellSize) / wallTexture.getSize().y
-        );
-        platformSprite.setScale(
-            static_cast<float>(cellSize) / platformTexture.getSize().x,
-            static_cast<float>(cellSize) / platformTexture.getSize().y
-        );
-        labyrinthBackgroundSprite.setScale(
-            static_cast<float>(BACKGROUND_WIDTH) / labyrinthBackgroundTexture.getSize().x,
-            static_cast<float>(BACKGROUND_HEIGHT) / labyrinthBackgroundTexture.getSize().y
-        );
-        breakableWallSprite.setScale(
-            static_cast<float>(cellSize) / breakableWallTexture.getSize().x,
-            static_cast<float>(cellSize) / breakableWallTexture.getSize().y
-        );
-    }
-
-    void draw(RenderWindow& window, float camera_offset_x) override {
-        // Calculate how many background tiles we need to draw
-        int startTile = static_cast<int>(camera_offset_x / BACKGROUND_WIDTH);
-        int endTile = static_cast<int>((camera_offset_x + SCREEN_WIDTH) / BACKGROUND_WIDTH) + 1;
-
-        // Draw background tiles
-        for (int tile = startTile; tile <= endTile; tile++) {
-            labyrinthBackgroundSprite.setPosition(
-                tile * BACKGROUND_WIDTH - camera_offset_x,
-                0
-            );
-            window.draw(labyrinthBackgroundSprite);
-        }
-
-        // Calculate visible cells
-        int startCol = static_cast<int>(camera_offset_x / cellSize);
-        int endCol = static_cast<int>((camera_offset_x + SCREEN_WIDTH) / cellSize) + 1;
-        startCol = max(0, startCol);
-        endCol = min(width - 1, endCol);
-
-        // Draw walls, platforms, and breakable walls
-        for (int i = 0; i < height; i++) {
-            for (int j = startCol; j <= endCol; j++) {
-                if (levelData[i][j] == 'w') {
-                    wallSprite.setPosition(
-                        j * cellSize - camera_offset_x,
-                        i * cellSize
-                    );
-                    window.draw(wallSprite);
-                }
-                else if (levelData[i][j] == 'p') {
-                    platformSprite.setPosition(
-                        j * cellSize - camera_offset_x,
-                        i * cellSize
-                    );
-                    window.draw(platformSprite);
-                }
-                else if (levelData[i][j] == 'b') {
-                    breakableWallSprite.setPosition(
-                        j * cellSize - camera_offset_x,
-                        i * cellSize
-                    );
-                    window.draw(breakableWallSprite);
-                }
-            }
-        }
-
-        // Draw obstacles
-        drawObstacles(window, camera_offset_x);
-
-        // Draw collectibles (rings)
-        drawCollectibles(window, camera_offset_x);
+        loadZoneTextures(zoneTextures(INDEX));
     }
 
     void createLevel() override {
-        // Clear the level first
-        for (int i = 0; i < height; i++)
-            for (int j = 0; j < width; j++)
-                levelData[i][j] = 's';
-
-        // Load from file using base class method
-        if (!Level::loadLayoutFromFile("Data/level1.txt")) {
+        // Compiled level (tools/LevelCompiler.cpp) first, the text layout if it is missing or stale
+        if (!loadCompiledLevel("Data/levels/zone1.lvb") && !Level::loadLayoutFromFile("Data/level1.txt")) {
             cout << "Falling back to default layout!" << endl;
         }
+        restoreLayout();
         spawnRandomEnemies(8);
 
     }
 
     void reset() override {
-        // Clear existing obstacles and collectibles
-        for (int i = 0; i < obstacleCount; ++i) {
-            delete obstacles[i];
-        }
-        obstacleCount = 0;
-        for (int i = 0; i < collectibleCount; ++i) {
-            delete collectibles[i];
-        }
-        collectibleCount = 0;
-        
-        initializeLevel();
-        createLevel();
+        // Restore the loaded layout (no file access) and respawn everything
+        enemyManager.clear();
+        restoreLayout();
+        spawnRandomEnemies(8);
     }
 };
 
 class IceCapZone : public Level {
-private:
-    Texture iceBackgroundTexture;
-    Sprite iceBackgroundSprite;
-    Texture breakableWallTexture;
-    Sprite breakableWallSprite;
-
 public:
+    static const int INDEX = 1;
+
     IceCapZone(ScoreManager* scoreMgr, HealthManager* healthMgr) : Level(250, 14, 64.0f, scoreMgr, healthMgr) {
-        // Ice physics - slippery! Higher friction value = less stopping power, more sliding
-        // Lower acceleration, higher max speed for momentum-based gameplay
-        physicsConfig = PhysicsConfig(0.25f, 18.0f, 0.985f, 0.1f, 0.65f, 18.0f, -17.0f, 0.4f);
+        physicsConfig = PhysicsConfig::iceCapZone();
         loadTextures();
         createLevel();
     }
 
     void loadTextures() override {
-        // Load level-specific textures
-        if (!wallTexture.loadFromFile("Data/ice_wall.png")) {
-            cout << "Failed to load ice wall texture" << endl;
-        }
-        if (!platformTexture.loadFromFile("Data/ice_platform.png")) {
-            cout << "Failed to load ice platform texture" << endl;
-        }
-        if (!iceBackgroundTexture.loadFromFile("Data/ice_background.png")) {
-            cout << "Failed to load ice background texture" << endl;
-        }
-        if (!breakableWallTexture.loadFromFile("Data/ice_breakable_wall.png")) {
-            cout << "Failed to load ice breakable wall texture" << endl;
-        }
-
-        wallSprite.setTexture(wallTexture);
-        platformSprite.setTexture(platformTexture);
-        iceBackgroundSprite.setTexture(iceBackgroundTexture);
-        breakableWallSprite.setTexture(breakableWallTexture);
-
-        // Set sprite scales to match cell size
-        wallSprite.setScale(
-            static_cast<float>(cellSize) / wallTexture.getSize().x,
-            static_cast<float>(cellSize) / wallTexture.getSize().y
-        );
-        platformSprite.setScale(
-            static_cast<float>(cellSize) / platformTexture.getSize().x,
-            static_cast<float>(cellSize) / platformTexture.getSize().y
-        );
-        iceBackgroundSprite.setScale(
-            static_cast<float>(BACKGROUND_WIDTH) / iceBackgroundTexture.getSize().x,
-            static_cast<float>(BACKGROUND_HEIGHT) / iceBackgroundTexture.getSize().y
-        );
-        breakableWallSprite.setScale(
-            static_cast<float>(cellSize) / breakableWallTexture.getSize().x,
-            static_cast<float>(cellSize) / breakableWallTexture.getSize().y
-        );
-    }
-
-    void draw(RenderWindow& window, float camera_offset_x) override {
-        // Calculate how many background tiles we need to draw
-        int startTile = static_cast<int>(camera_offset_x / BACKGROUND_WIDTH);
-        int endTile = static_cast<int>((camera_offset_x + SCREEN_WIDTH) / BACKGROUND_WIDTH) + 1;
-
-        // Draw background tiles
-        for (int tile = startTile; tile <= endTile; tile++) {
-            iceBackgroundSprite.setPosition(
-                tile * BACKGROUND_WIDTH - camera_offset_x,
-                0
-            );
-            window.draw(iceBackgroundSprite);
-        }
-
-        // Calculate visible cells
-        int startCol = static_cast<int>(camera_offset_x / cellSize);
-        int endCol = static_cast<int>((camera_offset_x + SCREEN_WIDTH) / cellSize) + 1;
-        startCol = max(0, startCol);
-        endCol = min(width - 1, endCol);
-
-        // Draw walls, platforms, and breakable walls
-        for (int i = 0; i < height; i++) {
-            for (int j = startCol; j <= endCol; j++) {
-                if (levelData[i][j] == 'w') {
-                    wallSprite.setPosition(
-                        j * cellSize - camera_offset_x,
-                        i * cellSize
-                    );
-                    window.draw(wallSprite);
-                }
-                else if (levelData[i][j] == 'p') {
-                    platformSprite.setPosition(
-                        j * cellSize - camera_offset_x,
-                        i * cellSize
-                    );
-                    window.draw(platformSprite);
-                }
-                else if (levelData[i][j] == 'b') {
-                    breakableWallSprite.setPosition(
-                        j * cellSize - camera_offset_x,
-                        i * cellSize
-                    );
-                    window.draw(breakableWallSprite);
-                }
-            }
-        }
-
-        drawObstacles(window, camera_offset_x);
-
-        // Draw collectibles (rings)
-        drawCollectibles(window, camera_offset_x);
+        loadZoneTextures(zoneTextures(INDEX));
     }
 
     void createLevel() override {
-        for (int i = 0; i < height; i++)
-            for (int j = 0; j < width; j++)
-                levelData[i][j] = 's';
-
-        // Load from file using base class method
-        if (!Level::loadLayoutFromFile("Data/level1.txt")) {
+        // Compiled level (tools/LevelCompiler.cpp) first, the text layout if it is missing or stale
+        if (!loadCompiledLevel("Data/levels/zone2.lvb") && !Level::loadLayoutFromFile("Data/level1.txt")) {
             cout << "Falling back to default layout!" << endl;
         }
+        restoreLayout();
         spawnRandomEnemies(12);
         //loadMusic("Data/level2.ogg");
     }
 
     void reset() override {
-        // Clear existing obstacles and collectibles
-        for (int i = 0; i < obstacleCount; ++i) {
-            delete obstacles[i];
-        }
-        obstacleCount = 0;
-        for (int i = 0; i < collectibleCount; ++i) {
-            delete collectibles[i];
-        }
-        collectibleCount = 0;
-        
-        initializeLevel();
-        createLevel();
+        // Restore the loaded layout (no file access) and respawn everything
+        enemyManager.clear();
+        restoreLayout();
+        spawnRandomEnemies(12);
     }
 };
 
 class DeathEggZone : public Level {
-private:
-    Texture deathEggBackgroundTexture;
-    Sprite deathEggBackgroundSprite;
-    Texture breakableWallTexture;
-    Sprite breakableWallSprite;
-
 public:
+    static const int INDEX = 2;
+
     DeathEggZone(ScoreManager* scoreMgr, HealthManager* healthMgr) : Level(300, 14, 64.0f, scoreMgr, healthMgr) {
-        // Space station physics - low gravity, floaty jumps, moderate control
-        physicsConfig = PhysicsConfig(0.35f, 14.0f, 0.94f, 0.15f, 0.35f, 12.0f, -15.0f, 0.7f);
+        physicsConfig = PhysicsConfig::deathEggZone();
         loadTextures();
         createLevel();
     }
 
     void loadTextures() override {
-        // Load level-specific textures
-        if (!wallTexture.loadFromFile("Data/deathegg_brick.png")) {
-            cout << "Failed to load death egg wall texture" << endl;
-        }
-        if (!platformTexture.loadFromFile("Data/deathegg_platform.png")) {
-            cout << "Failed to load death egg platform texture" << endl;
-        }
-        if (!deathEggBackgroundTexture.loadFromFile("Data/deathegg_background.png")) {
-            cout << "Failed to load death egg background texture" << endl;
-        }
-        if (!breakableWallTexture.loadFromFile("Data/death_breakable_wall.png")) {
-            cout << "Failed to load death egg breakable wall texture" << endl;
-        }
-        wallSprite.setTexture(wallTexture);
-        platformSprite.setTexture(platformTexture);
-        deathEggBackgroundSprite.setTexture(deathEggBackgroundTexture);
-        breakableWallSprite.setTexture(breakableWallTexture);
-
-        // Set sprite scales to match cell size
-        wallSprite.setScale(
-            static_cast<float>(cellSize) / wallTexture.getSize().x,
-            static_cast<float>(cellSize) / wallTexture.getSize().y
-        );
-        platformSprite.setScale(
-            static_cast<float>(cellSize) / platformTexture.getSize().x,
-            static_cast<float>(cellSize) / platformTexture.getSize().y
-        );
-        deathEggBackgroundSprite.setScale(
-            static_cast<float>(BACKGROUND_WIDTH) / deathEggBackgroundTexture.getSize().x,
-            static_cast<float>(BACKGROUND_HEIGHT) / deathEggBackgroundTexture.getSize().y
-        );
-        breakableWallSprite.setScale(
-            static_cast<float>(cellSize) / breakableWallTexture.getSize().x,
-            static_cast<float>(cellSize) / breakableWallTexture.getSize().y
-        );
-    }
-
-    void draw(RenderWindow& window, float camera_offset_x) override {
-        // Calculate how many background tiles we need to draw
-        int startTile = static_cast<int>(camera_offset_x / BACKGROUND_WIDTH);
-        int endTile = static_cast<int>((camera_offset_x + SCREEN_WIDTH) / BACKGROUND_WIDTH) + 1;
-
-        // Draw background tiles
-        for (int tile = startTile; tile <= endTile; tile++) {
-            deathEggBackgroundSprite.setPosition(
-                tile * BACKGROUND_WIDTH - camera_offset_x,
-                0
-            );
-            window.draw(deathEggBackgroundSprite);
-        }
-
-        // Calculate visible cells
-        int startCol = static_cast<int>(camera_offset_x / cellSize);
-        int endCol = static_cast<int>((camera_offset_x + SCREEN_WIDTH) / cellSize) + 1;
-        startCol = max(0, startCol);
-        endCol = min(width - 1, endCol);
-
-        // Draw walls, platforms, and breakable walls
-        for (int i = 0; i < height; i++) {
-            for (int j = startCol; j <= endCol; j++) {
-                if (levelData[i][j] == 'w') {
-                    wallSprite.setPosition(
-                        j * cellSize - camera_offset_x,
-                        i * cellSize
-                    );
-                    window.draw(wallSprite);
-                }
-                else if (levelData[i][j] == 'p') {
-                    platformSprite.setPosition(
-                        j * cellSize - camera_offset_x,
-                        i * cellSize
-                    );
-                    window.draw(platformSprite);
-                }
-                else if (levelData[i][j] == 'b') {
-                    breakableWallSprite.setPosition(
-                        j * cellSize - camera_offset_x,
-                        i * cellSize
-                    );
-                    window.draw(breakableWallSprite);
-                }
-            }
-        }
-        drawObstacles(window, camera_offset_x);
-
-        // Draw collectibles (rings)
-        drawCollectibles(window, camera_offset_x);
+        loadZoneTextures(zoneTextures(INDEX));
     }
 
     void createLevel() override {
-        for (int i = 0; i < height; i++)
-            for (int j = 0; j < width; j++)
-                levelData[i][j] = 's';
-
-        // Load from file using base class method
-        if (!Level::loadLayoutFromFile("Data/level1.txt")) {
+        // Compiled level (tools/LevelCompiler.cpp) first, the text layout if it is missing or stale
+        if (!loadCompiledLevel("Data/levels/zone3.lvb") && !Level::loadLayoutFromFile("Data/level1.txt")) {
             cout << "Falling back to default layout!" << endl;
         }
+        restoreLayout();
         spawnRandomEnemies(16);
         //loadMusic("Data/level3.ogg");
     }
 
     void reset() override {
-        // Clear existing obstacles and collectibles
-        for (int i = 0; i < obstacleCount; ++i) {
-            delete obstacles[i];
-        }
-        obstacleCount = 0;
-        for (int i = 0; i < collectibleCount; ++i) {
-            delete collectibles[i];
-        }
-        collectibleCount = 0;
-        
-        initializeLevel();
-        createLevel();
+        // Restore the loaded layout (no file access) and respawn everything
+        enemyManager.clear();
+        restoreLayout();
+        spawnRandomEnemies(16);
     }
 };
 
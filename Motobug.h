@@ -3,37 +3,44 @@
 
 #include "Enemy.h"
 
-class Motobug : public Enemy {
-    static const float TRACK_SPEED;
-    static const float ACTIVATION_RANGE;
+// Drives along the ground towards the player once they are in range
+class MotobugStore : public EnemyStore {
+    static constexpr float TRACK_SPEED = 60.0f;
+    static constexpr float ACTIVATION_RANGE = 300.0f;
 
 public:
-    Motobug(float startX, float startY) {
-        texture.loadFromFile("Data/motobug.png");
-        sprite.setTexture(texture);
-        sprite.setScale(1.0, 1.0);
-        posX = startX;
-        posY = startY;
-        health = 2;
-        speed = TRACK_SPEED;
-        width = 64.0f;
-        height = 64.0f;
+    MotobugStore() : EnemyStore(64.0f, 64.0f) {}
+
+    void loadTextures() {
+        loadTexture("Data/motobug.png", 1.0f);
+    }
+
+    void add(float startX, float startY) {
+        addEnemy(startX, startY, 2);
+    }
+
+    void clear() {
+        clearCommon();
     }
 
-    void update(float deltaTime, float playerX, float playerY) override {
-        if (!isAlive) return;
-        float dx = playerX - posX;
-        if (fabs(dx) < ACTIVATION_RANGE) {
-            if (dx > 0) posX += speed * deltaTime;
-            else posX -= speed * deltaTime;
+    void update(float deltaTime, float playerX, float /*playerY*/) {
+        const float step = TRACK_SPEED * deltaTime;
+        const int count = size();
+        for (int i = 0; i < count; i++) {
+            if (!alive[i]) continue;
+            float dx = playerX - posX[i];
+            if (fabs(dx) < ACTIVATION_RANGE) {
+                if (dx > 0) posX[i] += step;
+                else posX[i] -= step;
+            }
         }
     }
 
-    void draw(RenderWindow& window, float camera_offset_x) override {
-        Enemy::draw(window, camera_offset_x);
+    bool removeSpawnedOutside(float minX, float maxX) {
+        if (!selectSpawnedInside(minX, maxX)) return false;
+        compactCommon();
+        return true;
     }
 };
-const float Motobug::TRACK_SPEED = 60.0f;
-const float Motobug::ACTIVATION_RANGE = 300.0f;
 
-#endif // MOTOBUG_H 
\ No newline at end of file
+#endif // MOTOBUG_H
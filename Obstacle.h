@@ -1,6 +1,9 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include<iostream>
+#include "CollisionBatch.h"
+#include "RenderSnapshot.h"
+#include "SpriteBatch.h"
 
 using namespace sf;
 using namespace std;
@@ -18,9 +21,13 @@ public:
 
     // Pure virtual methods that must be implemented by derived classes
     virtual void update(float deltaTime) = 0;
-    virtual void draw(RenderWindow& window, float camera_offset_x) = 0;
+    virtual void draw(SpriteBatch& batch, float camera_offset_x) const = 0;
+    virtual void capture(RenderSnapshot& snapshot) const = 0;   // draw(), into a snapshot
     virtual bool checkCollision(float playerX, float playerY, float playerWidth, float playerHeight) = 0;
 
+    // False while the obstacle can't be hit (e.g. a broken wall)
+    virtual bool isSolid() const { return true; }
+
     // Getters
     float getX() const { return x; }
     float getY() const { return y; }
@@ -0,0 +1,98 @@
+#ifndef PARALLAX_BACKGROUND_H
+#define PARALLAX_BACKGROUND_H
+
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "TextureCache.h"
+
+using namespace sf;
+using namespace std;
+
+// One background layer as a zone describes it
+struct BackgroundLayerSpec {
+    const char* file;
+    float scrollFactor;     // Share of the camera's movement the layer follows: 1 moves with the level, 0 stays put
+    float tileWidth;        // Size one repeat of the image is drawn at
+    float tileHeight;
+    float top;
+};
+
+// A loaded layer
+struct ParallaxLayer {
+    const Texture* texture;
+    float scrollFactor;
+    Vector2f tileSize;
+    float top;
+};
+
+// The screen-wide quad that draws a layer. The texture repeats, so scrolling only
+// shifts the texture coordinates (kept within one repeat, so floats stay exact).
+// Returns false for a layer with nothing to draw.
+inline bool buildParallaxQuad(const ParallaxLayer& layer, float camera_offset_x, float screenWidth, Vertex* quad) {
+    if (!layer.texture || layer.tileSize.x <= 0) return false;
+    Vector2u size = layer.texture->getSize();
+    if (size.x == 0 || size.y == 0) return false;
+
+    float texelsPerPixel = size.x / layer.tileSize.x;
+    float left = fmod(camera_offset_x * layer.scrollFactor, layer.tileSize.x) * texelsPerPixel;
+    float right = left + screenWidth * texelsPerPixel;
+    float bottom = layer.top + layer.tileSize.y;
+    float v = static_cast<float>(size.y);
+
+    quad[0] = Vertex(Vector2f(0, layer.top), Vector2f(left, 0));
+    quad[1] = Vertex(Vector2f(screenWidth, layer.top), Vector2f(right, 0));
+    quad[2] = Vertex(Vector2f(screenWidth, bottom), Vector2f(right, v));
+    quad[3] = Vertex(Vector2f(0, bottom), Vector2f(left, v));
+    return true;
+}
+
+// A zone's background: layers drawn back to front, one draw call each wherever the
+// camera is
+class ParallaxBackground {
+private:
+    vector<TextureHandle> textures;
+    vector<ParallaxLayer> layers;
+    Vertex quad[4];
+
+public:
+    // Load the layers (back to front). Failed images leave their layer out.
+    bool load(const vector<BackgroundLayerSpec>& specs) {
+        textures.clear();
+        layers.clear();
+        bool loaded = true;
+        for (size_t i = 0; i < specs.size(); i++) {
+            TextureHandle texture;
+            if (!TextureCache::getInstance().acquire(specs[i].file, texture)) {
+                cout << "Failed to load background layer: " << specs[i].file << endl;
+                loaded = false;
+                continue;
+            }
+            // Set once: in threaded mode a render thread may be drawing it already
+            if (!texture->isRepeated()) texture->setRepeated(true);
+
+            ParallaxLayer layer;
+            layer.texture = texture.get();
+            layer.scrollFactor = specs[i].scrollFactor;
+            layer.tileSize = Vector2f(specs[i].tileWidth, specs[i].tileHeight);
+            layer.top = specs[i].top;
+            textures.push_back(texture);
+            layers.push_back(layer);
+        }
+        return loaded;
+    }
+
+    void draw(RenderWindow& window, float camera_offset_x, float screenWidth) {
+        RenderStates states;
+        for (size_t i = 0; i < layers.size(); i++) {
+            if (!buildParallaxQuad(layers[i], camera_offset_x, screenWidth, quad)) continue;
+            states.texture = layers[i].texture;
+            window.draw(quad, 4, Quads, states);
+        }
+    }
+
+    const vector<ParallaxLayer>& getLayers() const { return layers; }
+};
+
+#endif // PARALLAX_BACKGROUND_H
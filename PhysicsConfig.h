@@ -1,6 +1,8 @@
 #ifndef PHYSICSCONFIG_H
 #define PHYSICSCONFIG_H
 
+#include <string>
+
 class PhysicsConfig {
 private:
     float acceleration;      // Ground acceleration
@@ -29,6 +31,43 @@ public:
     float getJumpStrength() const { return jumpStrength; }
     float getAirControl() const { return airControl; }
 
+    // Zone presets. Compiled levels (tools/LevelCompiler.cpp) carry a copy of these,
+    // so change them here and recompile the levels.
+    static PhysicsConfig labyrinthZone() {
+        // Normal/balanced physics - good acceleration, responsive controls
+        return PhysicsConfig(0.45f, 15.0f, 0.92f, 0.2f, 0.65f, 18.0f, -18.0f, 0.6f);
+    }
+
+    static PhysicsConfig iceCapZone() {
+        // Ice physics - slippery! Higher friction value = less stopping power, more sliding
+        // Lower acceleration, higher max speed for momentum-based gameplay
+        return PhysicsConfig(0.25f, 18.0f, 0.985f, 0.1f, 0.65f, 18.0f, -17.0f, 0.4f);
+    }
+
+    static PhysicsConfig deathEggZone() {
+        // Space station physics - low gravity, floaty jumps, moderate control
+        return PhysicsConfig(0.35f, 14.0f, 0.94f, 0.15f, 0.35f, 12.0f, -15.0f, 0.7f);
+    }
+
+    // Preset by name ("labyrinth", "icecap", "deathegg")
+    static bool fromPresetName(const std::string& name, PhysicsConfig& out) {
+        if (name == "labyrinth") out = labyrinthZone();
+        else if (name == "icecap") out = iceCapZone();
+        else if (name == "deathegg") out = deathEggZone();
+        else return false;
+        return true;
+    }
+
+    // All values in constructor argument order (the compiled level layout)
+    void toArray(float out[8]) const {
+        out[0] = acceleration; out[1] = max_speed; out[2] = friction; out[3] = deceleration;
+        out[4] = gravity; out[5] = terminalVelocity; out[6] = jumpStrength; out[7] = airControl;
+    }
+
+    static PhysicsConfig fromArray(const float in[8]) {
+        return PhysicsConfig(in[0], in[1], in[2], in[3], in[4], in[5], in[6], in[7]);
+    }
+
     // Setters
     void setAcceleration(float v) { acceleration = v; }
     void setMaxSpeed(float v) { max_speed = v; }
@@ -11,6 +11,13 @@
 #include "Obstacle.h"
 #include "BreakableWall.h"
 #include "HealthManager.h"
+#include "AudioManager.h"
+#include "TextureCache.h"
+#include "RenderSnapshot.h"
+#include "SpriteBatch.h"
+#include "Animation.h"
+#include "FixedTimestep.h"
+#include "InputState.h"
 
 using namespace sf;
 using namespace std;
@@ -20,9 +27,10 @@ using namespace std;
 class Player {
 protected:
     float player_x, player_y;
+    float prev_x, prev_y;  // Position at the start of the current tick, for render interpolation
     float velocityX, velocityY;
-    Texture texture;
     Sprite sprite;
+    Animator animator;     // Sets the sprite's frame from the character's clips
     float scale_x, scale_y;
     int Pheight, Pwidth;
     int hit_box_factor_x, hit_box_factor_y;
@@ -31,13 +39,13 @@ protected:
     bool isVisible;  
     bool shouldTransitionLevel; 
     bool isInvulnerable;
-    Clock invulnClock;
+    float invulnTimer;  // Seconds since the last hit
     const float INVULN_TIME = 1.0f;
     bool isCurrentCharacter;  
 
     HealthManager* healthManager;
-    static bool isGameOver;
-    static bool mainCharacterFacingRight;
+    static inline bool isGameOver = false;
+    static inline bool mainCharacterFacingRight = true;
 
     // Physics constants - tuned for smooth, realistic movement
     float max_speed = 15;
@@ -69,49 +77,35 @@ protected:
     float abilityCooldown;
     float abilityDuration;
     bool abilityActive;
-    Clock abilityTimer;
-    Clock frameTimer;
 
-    Music jumpMusic;
-
-    bool check_wall_collision(char** lvl, float x, float y, int cell_size, int width, int height) {
+    bool check_wall_collision(const TileGrid& lvl, float x, float y, int cell_size) {
         int gridX = static_cast<int>(x) / cell_size;
         int gridY = static_cast<int>(y) / cell_size;
-
-        if (gridX < 0 || gridX >= width || gridY < 0 || gridY >= height)
-            return false;
-
-        return lvl[gridY][gridX] == 'w' || lvl[gridY][gridX] == 'b';  // Check for both walls and breakable walls
+        return lvl.isSolid(gridX, gridY);  // Walls and breakable walls
     }
 
-    bool check_platform_collision(char** lvl, float x, float bottom_y, int cell_size, int width, int height) {
+    bool check_platform_collision(const TileGrid& lvl, float x, float bottom_y, int cell_size) {
         int gridX = static_cast<int>(x) / cell_size;
         int gridY = static_cast<int>(bottom_y) / cell_size;
-
-        if (gridX < 0 || gridX >= width || gridY < 0 || gridY >= height)
-            return false;
-
-        return lvl[gridY][gridX] == 'p';  // Check for platforms
+        return lvl.isOneWay(gridX, gridY);  // Platforms
     }
 
     void handleCollisions(Level* level) {
         int cell_size = level->getCellSize();
-        char** lvl = level->getLevelData();
-        int width = level->getWidth();
-        int height = level->getHeight();
+        const TileGrid& lvl = level->getTiles();
 
         // Store original position
         float original_x = player_x;
         float original_y = player_y;
 
         // Try horizontal movement
-        player_x += velocityX;
+        player_x += velocityX * PHYSICS_STEP;
 
         // Check horizontal collisions
-        bool collisionLeftWall = check_wall_collision(lvl, player_x + hit_box_factor_x, player_y + hit_box_factor_y, cell_size, width, height) ||
-                               check_wall_collision(lvl, player_x + hit_box_factor_x, player_y + Pheight - hit_box_factor_y, cell_size, width, height);
-        bool collisionRightWall = check_wall_collision(lvl, player_x + Pwidth - hit_box_factor_x, player_y + hit_box_factor_y, cell_size, width, height) ||
-                                check_wall_collision(lvl, player_x + Pwidth - hit_box_factor_x, player_y + Pheight - hit_box_factor_y, cell_size, width, height);
+        bool collisionLeftWall = check_wall_collision(lvl, player_x + hit_box_factor_x, player_y + hit_box_factor_y, cell_size) ||
+                               check_wall_collision(lvl, player_x + hit_box_factor_x, player_y + Pheight - hit_box_factor_y, cell_size);
+        bool collisionRightWall = check_wall_collision(lvl, player_x + Pwidth - hit_box_factor_x, player_y + hit_box_factor_y, cell_size) ||
+                                check_wall_collision(lvl, player_x + Pwidth - hit_box_factor_x, player_y + Pheight - hit_box_factor_y, cell_size);
 
         // If there's a horizontal collision, revert the movement
         if (collisionLeftWall || collisionRightWall) {
@@ -120,7 +114,7 @@ protected:
         }
 
         // Try vertical movement
-        float offset_y = player_y + velocityY;
+        float offset_y = player_y + velocityY * PHYSICS_STEP;
 
         // Check if player is in the last pit
         if (level->isInLastPit(player_x, player_y)) {
@@ -130,19 +124,19 @@ protected:
 
         // Wall collisions (full collision)
         bool collisionBottomWallLeft = check_wall_collision(lvl, player_x + hit_box_factor_x,
-            offset_y + Pheight, cell_size, width, height);
+            offset_y + Pheight, cell_size);
         bool collisionBottomWallRight = check_wall_collision(lvl, player_x + Pwidth - hit_box_factor_x,
-            offset_y + Pheight, cell_size, width, height);
+            offset_y + Pheight, cell_size);
         bool collisionBottomWallMid = check_wall_collision(lvl, player_x + Pwidth / 2,
-            offset_y + Pheight, cell_size, width, height);
+            offset_y + Pheight, cell_size);
 
         // Platform collisions (top-side only)
         bool collisionPlatformLeft = check_platform_collision(lvl, player_x + hit_box_factor_x,
-            offset_y + Pheight, cell_size, width, height);
+            offset_y + Pheight, cell_size);
         bool collisionPlatformRight = check_platform_collision(lvl, player_x + Pwidth - hit_box_factor_x,
-            offset_y + Pheight, cell_size, width, height);
+            offset_y + Pheight, cell_size);
         bool collisionPlatformMid = check_platform_collision(lvl, player_x + Pwidth / 2,
-            offset_y + Pheight, cell_size, width, height);
+            offset_y + Pheight, cell_size);
 
         // Handle wall collisions (full collision)
         if (collisionBottomWallLeft || collisionBottomWallMid || collisionBottomWallRight) {
@@ -164,19 +158,24 @@ protected:
 
 public:
     Player(float start_x, float start_y, HealthManager* healthMgr, float scale = 2.5f) :
-        player_x(start_x), player_y(start_y), scale_x(scale), scale_y(scale),
-        isInvulnerable(false), isCurrentCharacter(false), healthManager(healthMgr)
+        player_x(start_x), player_y(start_y), prev_x(start_x), prev_y(start_y), scale_x(scale), scale_y(scale),
+        isInvulnerable(false), invulnTimer(0.0f), isCurrentCharacter(false), healthManager(healthMgr)
     {
         // Initialize state
         velocityX = 0;
         velocityY = 0;
         onGround = false;
+        justJumped = false;
+        abilityCooldown = 0.0f;
+        abilityDuration = 0.0f;
+        abilityActive = false;
         isVisible = true;  // Initialize as visible
         shouldTransitionLevel = false;
-        jumpMusic.openFromFile("Data/Jump.wav");
-        jumpMusic.setVolume(30);
+        AudioManager::getInstance().preloadSound("Data/Jump.wav");
     }
 
+    virtual ~Player() = default;
+
     // Static method to check if game is over
     static bool isGameOverState() { return isGameOver; }
 
@@ -193,10 +192,18 @@ public:
         mainCharacterFacingRight = facingRight;
     }
 
-    virtual void handleInput(Level* level)
+    // Show this tick's animation; run cycles play faster the faster the character goes
+    void animate(AnimationState state) {
+        float rate = 1.0f;
+        if (state == ANIM_RUN && max_speed > 0) {
+            rate = 0.5f + min(1.0f, abs(velocityX) / max_speed);
+        }
+        animator.update(state, SIM_DT * rate);
+    }
+
+    virtual void handleInput(Level* level, const InputState& input)
     {
-        float deltaTime = frameTimer.restart().asSeconds();
-        if (deltaTime > 0.1f) deltaTime = 0.016f; // Cap delta time
+        float deltaTime = SIM_DT;
         
         PhysicsConfig* phys = level ? level->getPhysicsConfig() : nullptr;
         float maxSpd = phys ? phys->getMaxSpeed() : max_speed;
@@ -205,20 +212,20 @@ public:
         float currentAccel = onGround ? groundAcceleration : airAcceleration;
         float currentFriction = onGround ? groundFriction : airFriction;
         
-        bool movingRight = Keyboard::isKeyPressed(Keyboard::Right);
-        bool movingLeft = Keyboard::isKeyPressed(Keyboard::Left);
+        bool movingRight = input.isDown(INPUT_RIGHT);
+        bool movingLeft = input.isDown(INPUT_LEFT);
         
         // Horizontal movement with smooth acceleration
         if (movingRight && !movingLeft) {
             // Check if turning around (was moving left, now moving right)
             if (velocityX < -skidThreshold) {
                 // Skidding - apply extra deceleration for snappy turn-around
-                velocityX += currentAccel + turnAroundBoost;
+                velocityX += (currentAccel + turnAroundBoost) * PHYSICS_STEP;
             } else {
                 // Normal acceleration with diminishing returns near max speed
                 float speedRatio = abs(velocityX) / maxSpd;
                 float adjustedAccel = currentAccel * (1.0f - speedRatio * 0.5f);
-                velocityX += adjustedAccel;
+                velocityX += adjustedAccel * PHYSICS_STEP;
             }
             if (velocityX > maxSpd) velocityX = maxSpd;
         }
@@ -226,18 +233,18 @@ public:
             // Check if turning around (was moving right, now moving left)
             if (velocityX > skidThreshold) {
                 // Skidding - apply extra deceleration for snappy turn-around
-                velocityX -= currentAccel + turnAroundBoost;
+                velocityX -= (currentAccel + turnAroundBoost) * PHYSICS_STEP;
             } else {
                 // Normal acceleration with diminishing returns near max speed
                 float speedRatio = abs(velocityX) / maxSpd;
                 float adjustedAccel = currentAccel * (1.0f - speedRatio * 0.5f);
-                velocityX -= adjustedAccel;
+                velocityX -= adjustedAccel * PHYSICS_STEP;
             }
             if (velocityX < -maxSpd) velocityX = -maxSpd;
         }
         else {
             // Apply friction when not pressing left/right (multiplicative for smooth stop)
-            velocityX *= currentFriction;
+            velocityX *= pow(currentFriction, PHYSICS_STEP);
             // Snap to zero when very slow to prevent sliding forever
             if (abs(velocityX) < 0.1f) velocityX = 0;
         }
@@ -250,7 +257,7 @@ public:
         }
         
         // Jump buffer - remember jump input slightly before landing
-        if (Keyboard::isKeyPressed(Keyboard::Space)) {
+        if (input.isDown(INPUT_JUMP)) {
             if (jumpReleased) {
                 jumpBufferTimer = jumpBufferTime;
                 jumpReleased = false;
@@ -271,7 +278,7 @@ public:
         
         // Variable jump height - cut velocity when releasing jump button early
         if (!jumpHeld && velocityY < 0 && !onGround) {
-            velocityY *= jumpCutMultiplier + (1.0f - jumpCutMultiplier) * 0.5f;
+            velocityY *= pow(jumpCutMultiplier + (1.0f - jumpCutMultiplier) * 0.5f, PHYSICS_STEP);
         }
     }
 
@@ -287,7 +294,7 @@ public:
         onGround = false;
         justJumped = true;
         coyoteTimer = 0;
-        jumpMusic.play();
+        AudioManager::getInstance().playSound("Data/Jump.wav", 30, SOUND_PRIORITY_HIGH);
     }
 
     virtual void updatePhysics(Level* level) 
@@ -300,7 +307,7 @@ public:
         if (!onGround) {
             // Apply stronger gravity when falling (more satisfying arc)
             float gravityMultiplier = (velocityY > 0) ? 1.2f : 1.0f;
-            velocityY += grav * gravityMultiplier;
+            velocityY += grav * gravityMultiplier * PHYSICS_STEP;
             
             // Smooth approach to terminal velocity
             if (velocityY > termVel) {
@@ -326,7 +333,7 @@ public:
         level->checkCollectibleCollisions(player_x, player_y, Pwidth, Pheight);
 
         // Reset color and invulnerability after duration
-        if (isInvulnerable && invulnClock.getElapsedTime().asSeconds() >= INVULN_TIME) {
+        if (isInvulnerable && invulnTimer >= INVULN_TIME) {
             isInvulnerable = false;
             sprite.setColor(Color::White);
         }
@@ -340,18 +347,36 @@ public:
         }
     }
 
-    virtual void draw(RenderWindow& window, float camera_offset_x) {
+    // alpha: how far rendering is between the previous tick (0) and the current one (1)
+    virtual void draw(SpriteBatch& batch, float camera_offset_x, float alpha = 1.0f) const {
         if (isVisible) {  // Only draw if visible
-        sprite.setPosition((player_x - camera_offset_x), player_y);
-        window.draw(sprite);
+            batch.submit(sprite, getRenderX(alpha) - camera_offset_x, getRenderY(alpha), LAYER_PLAYERS);
         }
     }
 
+    void capture(RenderSnapshot& snapshot) const {
+        if (isVisible) {
+            snapshot.addSprite(sprite, prev_x, prev_y, player_x, player_y, LAYER_PLAYERS);
+        }
+    }
+
+    // Remember where the player was at the start of a tick
+    void storePreviousPosition() {
+        prev_x = player_x;
+        prev_y = player_y;
+    }
+
+    float getRenderX(float alpha) const { return interpolate(prev_x, player_x, alpha); }
+    float getRenderY(float alpha) const { return interpolate(prev_y, player_y, alpha); }
+
     virtual float getMaxSpeed() = 0;
 	virtual void setPosition(float x, float y) 
     { 
+        // Teleports snap - don't interpolate across them
         player_x = x; 
         player_y = y; 
+        prev_x = x;
+        prev_y = y;
     }
     virtual void setVelocity(float vx, float vy) 
     { 
@@ -398,7 +423,7 @@ public:
             sprite.setColor(Color(255, 0, 0, 128));
             // Set invulnerability
             isInvulnerable = true;
-            invulnClock.restart();
+            invulnTimer = 0.0f;
             if (healthManager && healthManager->getHealth() <= 0) {
                 cout << "Game Over! Health reached 0" << endl;
                 isGameOver = true;
@@ -416,15 +441,17 @@ public:
     void incrementSharedHealth() { if (healthManager) healthManager->incrementHealth(); }
 
     bool getIsInvulnerable() const { return isInvulnerable; }
+    float getAbilityCooldown() const { return abilityCooldown; }
 	void setIsInvulnerable(bool invulnerable) { isInvulnerable = invulnerable; }
 
-    void updateInvulnerability() {
-        if (isInvulnerable && invulnClock.getElapsedTime().asSeconds() > INVULN_TIME) {
-            isInvulnerable = false;
+    void updateInvulnerability(float deltaTime) {
+        if (isInvulnerable) {
+            invulnTimer += deltaTime;
+            if (invulnTimer > INVULN_TIME) {
+                isInvulnerable = false;
+            }
         }
     }
 };
 
-bool Player::isGameOver = false;
-bool Player::mainCharacterFacingRight = true;
 #endif // PLAYER_H
\ No newline at end of file
@@ -13,12 +13,10 @@ private:
 	Player* characters[3];
 	Player* currentPlayer;
 	const float gap = 50.0f;
-	Clock abilityClock;
 	bool currentFacingRight;  
 	const float PIT_THRESHOLD = 800.0f; 
 	
 	// Respawn system - per character tracking
-	Clock respawnTimers[3];
 	bool needsRespawn[3];
 	float lastSafeX[3];  // Track last safe X position for each character
 	const float RESPAWN_DELAY = 0.5f; 
@@ -29,25 +27,32 @@ private:
 	const float START_Y = 100.0f;
 	HealthManager* healthManager;
 	
-	// Find safe respawn position on solid ground
+	// Seconds until the next character switch is allowed
+	float switchCooldown;
+	const float SWITCH_COOLDOWN = 0.5f;
+
+public:
+	// Find safe respawn position on solid ground (public for the benchmarks)
 	void findSafeRespawnPosition(Level* level, float pitX, float& outX, float& outY) {
 		float cellSize = level->getCellSize();
-		char** levelData = level->getLevelData();
+		const TileGrid& tiles = level->getTiles();
 		int levelWidth = level->getWidth();
 		int levelHeight = level->getHeight();
 		
 		// Start searching from the pit position, going backwards
 		int startGridX = static_cast<int>(pitX / cellSize) - RESPAWN_BLOCKS_BEHIND;
 		if (startGridX < 0) startGridX = 0;
+		if (startGridX > tiles.getLastResident()) startGridX = tiles.getLastResident();
 		
 		// Search for solid ground (wall 'w' or platform 'p') with empty space above
-		for (int searchX = startGridX; searchX >= 0; searchX--) {
+		// (only the loaded columns of a streamed level can be searched)
+		for (int searchX = startGridX; searchX >= tiles.getFirstResident(); searchX--) {
 			for (int searchY = levelHeight - 2; searchY >= 0; searchY--) {
-				char cell = levelData[searchY][searchX];
-				char cellAbove = (searchY > 0) ? levelData[searchY - 1][searchX] : 's';
+				TileType cell = tiles.get(searchX, searchY);
+				TileType cellAbove = tiles.get(searchX, searchY - 1);
 				
 				// Found solid ground with space above
-				if ((cell == 'w' || cell == 'p') && (cellAbove == 's' || cellAbove == 'r')) {
+				if ((cell == TILE_WALL || cell == TILE_PLATFORM) && cellAbove == TILE_EMPTY) {
 					outX = searchX * cellSize + cellSize / 2;
 					outY = (searchY - 1) * cellSize;  // Position above the ground
 					return;
@@ -60,9 +65,8 @@ private:
 		outY = START_Y;
 	}
 
-public:
 	// Constructor
-	PlayerManager(HealthManager* healthMgr) : healthManager(healthMgr) {
+	PlayerManager(HealthManager* healthMgr) : healthManager(healthMgr), switchCooldown(0.0f) {
 		characters[0] = new Sonic(START_X, START_Y, healthManager);
 		characters[1] = new Tails(START_X, START_Y, healthManager);
 		characters[2] = new Knuckles(START_X, START_Y, healthManager);
@@ -79,7 +83,6 @@ public:
 			lastSafeX[i] = START_X;
 		}
 		
-		abilityClock.restart();
 		currentFacingRight = true;  
 	}
 
@@ -106,11 +109,10 @@ public:
 	void switchCharacter() 
 	{
 		// Check cooldown BEFORE switching to prevent rapid switching
-		static Clock switchCooldown;
-		if (switchCooldown.getElapsedTime().asSeconds() < 0.5f) {
+		if (switchCooldown > 0.0f) {
 			return;
 		}
-		switchCooldown.restart();
+		switchCooldown = SWITCH_COOLDOWN;
 
 		float x = currentPlayer->getX();
 		float y = currentPlayer->getY();
@@ -142,11 +144,11 @@ public:
 		Player::updateMainCharacterDirection(currentFacingRight);
 	}
 
-	void handleInput(Level* level)
+	void handleInput(Level* level, const InputState& input)
 	{
-		static Clock switchCooldown;
+		switchCooldown = max(0.0f, switchCooldown - SIM_DT);
 
-		currentPlayer->handleInput(level);
+		currentPlayer->handleInput(level, input);
 
 		// Update facing direction based on current character's velocity
 		if (currentPlayer->getVelX() > 0) {
@@ -158,20 +160,18 @@ public:
 			Player::updateMainCharacterDirection(false);
 		}
 
-		if (Keyboard::isKeyPressed(Keyboard::Z) &&
-			switchCooldown.getElapsedTime().asSeconds() > 0.5f) {
+		if (input.isDown(INPUT_SWITCH)) {
 			switchCharacter();
-			switchCooldown.restart();
 		}
 
-		if (Keyboard::isKeyPressed(Keyboard::LControl)) {
+		if (input.isDown(INPUT_ABILITY)) {
 			currentPlayer->activateAbility(level);
 		}
 	}
 
 	void updatePhysics(Level* level)
 	{
-		float deltaTime = abilityClock.restart().asSeconds();
+		float deltaTime = SIM_DT;
 		
 		bool jumpCommand = currentPlayer->hasJustJumped();
 		currentPlayer->updatePhysics(level);
@@ -274,13 +274,35 @@ public:
 		}
 	}
 
-	void draw(RenderWindow& window, float camera_offset_x) 
+	// Called at the start of every simulation tick
+	void storePreviousPositions()
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			characters[i]->storePreviousPosition();
+		}
+	}
+
+	void draw(SpriteBatch& batch, float camera_offset_x, float alpha = 1.0f) 
 	{
 		for (int i = 0; i < 3; ++i) 
 		{
-			characters[i]->draw(window, camera_offset_x);
+			characters[i]->draw(batch, camera_offset_x, alpha);
+		}
+	}
+
+	void capture(RenderSnapshot& snapshot) const
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			characters[i]->capture(snapshot);
 		}
 	}
 
 	Player* getCurrentPlayer() const { return currentPlayer; }
+	Player* getCharacter(int idx) const { return (idx >= 0 && idx < 3) ? characters[idx] : nullptr; }
+
+	// Ability timers for the HUD
+	float getBoostCooldown() const { return characters[0]->getAbilityCooldown(); }
+	float getFlightTimeRemaining() const { return static_cast<Tails*>(characters[1])->getFlightTimeRemaining(); }
 };
\ No newline at end of file
@@ -0,0 +1,175 @@
+#ifndef PROJECTILE_POOL_H
+#define PROJECTILE_POOL_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "FixedTimestep.h"
+#include "RenderSnapshot.h"
+#include "SpriteBatch.h"
+
+using namespace sf;
+using namespace std;
+
+// What fired a projectile; decides its size and colour
+enum ProjectileKind {
+    PROJECTILE_BEEBOT = 0,
+    PROJECTILE_CRABMEAT,
+    PROJECTILE_KIND_COUNT
+};
+
+// Every enemy shot in a level, in one fixed-capacity pool. Slots are handed out from
+// a free list and the fields are kept as parallel arrays, so moving all shots is one
+// straight loop the compiler can vectorise and drawing them is one vertex array.
+// Each shot remembers its owner (enemy type and index) so enemies can cap how many
+// of their shots are alive at once.
+class ProjectilePool {
+public:
+    static const int CAPACITY = 4096;
+
+    vector<float> x, y;
+    vector<float> prevX, prevY;   // For render interpolation
+    vector<float> velX, velY;
+    vector<unsigned char> kind;
+    vector<unsigned char> active;
+    vector<int> ownerType;
+    vector<int> ownerIndex;       // -1 once the owner is gone
+
+private:
+    vector<int> freeSlots;        // Stack; lowest slots come off first
+    int usedSlots;                // One past the highest slot ever handed out since clear()
+    int activeCount;
+
+    static Vector2f sizeOf(int projectileKind) {
+        return projectileKind == PROJECTILE_BEEBOT ? Vector2f(8.0f, 8.0f) : Vector2f(10.0f, 6.0f);
+    }
+
+    static Color colorOf(int projectileKind) {
+        return projectileKind == PROJECTILE_BEEBOT ? Color::Red : Color::Yellow;
+    }
+
+public:
+    ProjectilePool() : usedSlots(0), activeCount(0) {
+        x.assign(CAPACITY, 0.0f);
+        y.assign(CAPACITY, 0.0f);
+        prevX.assign(CAPACITY, 0.0f);
+        prevY.assign(CAPACITY, 0.0f);
+        velX.assign(CAPACITY, 0.0f);
+        velY.assign(CAPACITY, 0.0f);
+        kind.assign(CAPACITY, 0);
+        active.assign(CAPACITY, 0);
+        ownerType.assign(CAPACITY, -1);
+        ownerIndex.assign(CAPACITY, -1);
+        freeSlots.reserve(CAPACITY);
+        clear();
+    }
+
+    void clear() {
+        for (int i = 0; i < usedSlots; i++) {
+            active[i] = 0;
+            velX[i] = velY[i] = 0.0f;
+        }
+        freeSlots.clear();
+        for (int i = CAPACITY - 1; i >= 0; i--) {
+            freeSlots.push_back(i);
+        }
+        usedSlots = 0;
+        activeCount = 0;
+    }
+
+    // Fire a shot; returns its slot, or -1 if the pool is full
+    int spawn(ProjectileKind projectileKind, float startX, float startY, float vx, float vy, int owner, int index) {
+        if (freeSlots.empty()) return -1;
+        int slot = freeSlots.back();
+        freeSlots.pop_back();
+        if (slot >= usedSlots) usedSlots = slot + 1;
+
+        x[slot] = prevX[slot] = startX;
+        y[slot] = prevY[slot] = startY;
+        velX[slot] = vx;
+        velY[slot] = vy;
+        kind[slot] = static_cast<unsigned char>(projectileKind);
+        active[slot] = 1;
+        ownerType[slot] = owner;
+        ownerIndex[slot] = index;
+        activeCount++;
+        return slot;
+    }
+
+    void release(int slot) {
+        if (!active[slot]) return;
+        active[slot] = 0;
+        velX[slot] = velY[slot] = 0.0f;
+        freeSlots.push_back(slot);
+        activeCount--;
+    }
+
+    void storePreviousPositions() {
+        for (int i = 0; i < usedSlots; i++) {
+            prevX[i] = x[i];
+            prevY[i] = y[i];
+        }
+    }
+
+    // Move every shot. Free slots have zero velocity, so the loop needs no branch.
+    void integrate(float deltaTime) {
+        float* px = x.data();
+        float* py = y.data();
+        const float* vx = velX.data();
+        const float* vy = velY.data();
+        for (int i = 0; i < usedSlots; i++) {
+            px[i] += vx[i] * deltaTime;
+            py[i] += vy[i] * deltaTime;
+        }
+    }
+
+    // Release every shot outside the bounds (the camera view plus a margin).
+    // onRelease(slot) runs before each release, while the owner is still readable.
+    template <typename Callback>
+    void cull(const FloatRect& bounds, Callback onRelease) {
+        float right = bounds.left + bounds.width;
+        float bottom = bounds.top + bounds.height;
+        for (int i = 0; i < usedSlots; i++) {
+            if (active[i] && (x[i] < bounds.left || x[i] > right || y[i] < bounds.top || y[i] > bottom)) {
+                onRelease(i);
+                release(i);
+            }
+        }
+    }
+
+    // Point shots at their owners' new indices after an enemy store was compacted
+    // (remap[old index] = new index, or -1 if the owner was removed)
+    void remapOwners(int owner, const vector<int>& remap) {
+        for (int i = 0; i < usedSlots; i++) {
+            if (active[i] && ownerType[i] == owner && ownerIndex[i] >= 0) {
+                ownerIndex[i] = ownerIndex[i] < static_cast<int>(remap.size()) ? remap[ownerIndex[i]] : -1;
+            }
+        }
+    }
+
+    bool getBounds(int slot, FloatRect& bounds) const {
+        if (slot < 0 || slot >= usedSlots || !active[slot]) return false;
+        Vector2f size = sizeOf(kind[slot]);
+        bounds = FloatRect(x[slot], y[slot], size.x, size.y);
+        return true;
+    }
+
+    // Untextured and vertex-coloured, so all shots end up in one draw call
+    void draw(SpriteBatch& batch, float camera_offset_x, float alpha = 1.0f) const {
+        for (int i = 0; i < usedSlots; i++) {
+            if (!active[i]) continue;
+            batch.submitRect(interpolate(prevX[i], x[i], alpha) - camera_offset_x, interpolate(prevY[i], y[i], alpha),
+                sizeOf(kind[i]), colorOf(kind[i]), LAYER_SHOTS);
+        }
+    }
+
+    void capture(RenderSnapshot& snapshot) const {
+        for (int i = 0; i < usedSlots; i++) {
+            if (active[i]) snapshot.addShot(prevX[i], prevY[i], x[i], y[i], sizeOf(kind[i]), colorOf(kind[i]));
+        }
+    }
+
+    int getUsedSlots() const { return usedSlots; }
+    int getActiveCount() const { return activeCount; }
+};
+
+#endif // PROJECTILE_POOL_H
@@ -0,0 +1,195 @@
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "TextureCache.h"
+#include "FixedTimestep.h"
+#include "ParallaxBackground.h"
+#include "SpriteBatch.h"
+#include "Hud.h"
+
+using namespace sf;
+using namespace std;
+
+// A sprite as the simulation left it, in world coordinates. Moving sprites also carry
+// where they were on the previous tick, so the renderer can interpolate.
+struct SpriteRecord {
+    const Texture* texture;
+    IntRect rect;
+    Vector2f previous;
+    Vector2f position;
+    Vector2f scale;
+    Vector2f origin;
+    Color color;
+    int layer;                  // DrawLayer
+};
+
+// A run of tile vertices (world coordinates) drawn with one texture
+struct TileBatchRecord {
+    const Texture* texture;
+    size_t first;
+    size_t count;
+};
+
+// An untextured enemy shot
+struct ShotRecord {
+    Vector2f previous;
+    Vector2f position;
+    Vector2f size;
+    Color color;
+};
+
+// Everything needed to draw one simulation tick, copied out of the world so a render
+// thread can draw it while the simulation moves on (see GameManager's threaded mode).
+// Snapshots are reused: clear() keeps the vectors' capacity.
+struct RenderSnapshot {
+    typedef chrono::steady_clock SnapshotClock;
+
+    // Keeps every texture the records point to alive until the snapshot is reused,
+    // even if the simulation drops a zone meanwhile
+    vector<TextureHandle> textures;
+    // Handles from the slot's earlier uses. clear() runs on the simulation thread, so it
+    // moves them here instead of dropping them (which could free a texture there); the
+    // render thread lets go of them with releaseRetired() once it has the snapshot.
+    vector<TextureHandle> retired;
+
+    // Drawn in this order
+    vector<ParallaxLayer> background;
+    vector<Vertex> tileVertices;
+    vector<TileBatchRecord> tileBatches;
+    vector<SpriteRecord> sprites;      // Then these and the shots, by layer
+    vector<ShotRecord> shots;
+
+    float previousCamera;
+    float camera;
+    HudValues hud;
+    bool gameOver;
+    unsigned long long tick;
+    int culled;                         // Entities the capture skipped as off screen
+    SnapshotClock::time_point published;
+
+    RenderSnapshot()
+        : previousCamera(0), camera(0), gameOver(false), tick(0), culled(0) {}
+
+    void clear() {
+        // A slot the renderer skipped comes back with its handles still retired; the
+        // same textures recur every tick, so keep one handle each
+        for (size_t i = 0; i < textures.size(); i++) {
+            if (find(retired.begin(), retired.end(), textures[i]) == retired.end()) {
+                retired.push_back(std::move(textures[i]));
+            }
+        }
+        textures.clear();
+        background.clear();
+        tileVertices.clear();
+        tileBatches.clear();
+        sprites.clear();
+        shots.clear();
+    }
+
+    // Render thread
+    void releaseRetired() {
+        retired.clear();
+    }
+
+    static SpriteRecord record(const Sprite& sprite, float previousX, float previousY, float x, float y, int layer) {
+        SpriteRecord record;
+        record.texture = sprite.getTexture();
+        record.rect = sprite.getTextureRect();
+        record.previous = Vector2f(previousX, previousY);
+        record.position = Vector2f(x, y);
+        record.scale = sprite.getScale();
+        record.origin = sprite.getOrigin();
+        record.color = sprite.getColor();
+        record.layer = layer;
+        return record;
+    }
+
+    void addBackground(const ParallaxLayer& layer) {
+        background.push_back(layer);
+    }
+    void addSprite(const Sprite& sprite, float x, float y, int layer) {
+        sprites.push_back(record(sprite, x, y, x, y, layer));
+    }
+    void addSprite(const Sprite& sprite, float previousX, float previousY, float x, float y, int layer) {
+        sprites.push_back(record(sprite, previousX, previousY, x, y, layer));
+    }
+
+    void addTiles(const Texture* texture, const VertexArray& vertices) {
+        TileBatchRecord batch;
+        batch.texture = texture;
+        batch.first = tileVertices.size();
+        batch.count = vertices.getVertexCount();
+        for (size_t i = 0; i < batch.count; i++) {
+            tileVertices.push_back(vertices[i]);
+        }
+        tileBatches.push_back(batch);
+    }
+
+    void addShot(float previousX, float previousY, float x, float y, Vector2f size, Color color) {
+        ShotRecord shot;
+        shot.previous = Vector2f(previousX, previousY);
+        shot.position = Vector2f(x, y);
+        shot.size = size;
+        shot.color = color;
+        shots.push_back(shot);
+    }
+};
+
+// Draws snapshots. Only reads the snapshot, so it can run on another thread than the
+// simulation that wrote it.
+class SnapshotRenderer {
+private:
+    Vertex backgroundQuad[4];
+    SpriteBatch batch;
+
+public:
+
+    // How far the display is between the snapshot's previous tick and its own, going
+    // by how long ago it was published
+    static float alphaOf(const RenderSnapshot& snapshot) {
+        float elapsed = chrono::duration<float>(RenderSnapshot::SnapshotClock::now() - snapshot.published).count();
+        return min(1.0f, max(0.0f, elapsed / SIM_DT));
+    }
+
+    // The world (not the HUD) as of the snapshot
+    void draw(RenderWindow& window, const RenderSnapshot& snapshot, float alpha) {
+        float camera = interpolate(snapshot.previousCamera, snapshot.camera, alpha);
+        float screenWidth = window.getView().getSize().x;
+        RenderStates layerStates;
+        for (size_t i = 0; i < snapshot.background.size(); i++) {
+            if (!buildParallaxQuad(snapshot.background[i], camera, screenWidth, backgroundQuad)) continue;
+            layerStates.texture = snapshot.background[i].texture;
+            window.draw(backgroundQuad, 4, Quads, layerStates);
+        }
+
+        RenderStates states;
+        states.transform.translate(-camera, 0);
+        for (size_t i = 0; i < snapshot.tileBatches.size(); i++) {
+            const TileBatchRecord& batch = snapshot.tileBatches[i];
+            if (batch.count == 0) continue;
+            states.texture = batch.texture;
+            window.draw(&snapshot.tileVertices[batch.first], batch.count, Quads, states);
+        }
+
+        for (size_t i = 0; i < snapshot.sprites.size(); i++) {
+            const SpriteRecord& record = snapshot.sprites[i];
+            if (!record.texture) continue;
+            batch.submit(record.texture, record.rect, interpolate(record.previous.x, record.position.x, alpha) - camera,
+                interpolate(record.previous.y, record.position.y, alpha), record.origin, record.scale, record.color, record.layer);
+        }
+        for (size_t i = 0; i < snapshot.shots.size(); i++) {
+            const ShotRecord& shot = snapshot.shots[i];
+            batch.submitRect(interpolate(shot.previous.x, shot.position.x, alpha) - camera,
+                interpolate(shot.previous.y, shot.position.y, alpha), shot.size, shot.color, LAYER_SHOTS);
+        }
+        batch.flush(window);
+    }
+
+    const SpriteBatch& getBatch() const { return batch; }
+};
+
+#endif // RENDER_SNAPSHOT_H
@@ -4,38 +4,39 @@
 #include "Collectible.h"
 #include <SFML/Graphics.hpp>
 #include "ScoreManager.h"
+#include "AudioManager.h"
 
 using namespace sf;
 using namespace std;
 
 class Ring : public Collectible {
 private:
-    static Texture ringTexture;
+    TextureRegion ringTexture;
     Sprite sprite;
     int currentFrame;
     float frameTimer;
-    static float frameDuration; // seconds per frame
-    static int totalFrames;
-    static int frameWidth;
-    static int frameHeight;
-    Music ringMusic;
+    static inline float frameDuration = 0.1f; // seconds per frame
+    static inline int totalFrames = 4;
+    static inline int frameWidth = 16;
+    static inline int frameHeight = 16;
     ScoreManager* scoreManager;
 
+    // Frames are laid out left to right inside the ring's texture region
+    IntRect getFrameRect(int frame) const {
+        return IntRect(ringTexture.rect.left + frame * frameWidth, ringTexture.rect.top, frameWidth, frameHeight);
+    }
 
 public:
     Ring(float startX, float startY, ScoreManager* scoreMgr, float scale = 2.0f)
         : Collectible(startX, startY, scale), currentFrame(0), frameTimer(0.0f), scoreManager(scoreMgr) {
         width = frameWidth * scale;
         height = frameHeight * scale;
-        if (ringTexture.getSize().x == 0) {
-            ringTexture.loadFromFile("Data/ring.png");
-        }
-        sprite.setTexture(ringTexture);
-        sprite.setTextureRect(IntRect(0, 0, frameWidth, frameHeight));
+        TextureCache::getInstance().acquireRegion("Data/ring.png", ringTexture);
+        sprite.setTexture(*ringTexture.texture);
+        sprite.setTextureRect(getFrameRect(0));
         sprite.setScale(scale, scale);
         sprite.setPosition(x, y);
-        ringMusic.openFromFile("Data/Ring.wav");
-        ringMusic.setVolume(30);
+        AudioManager::getInstance().preloadSound("Data/Ring.wav");
     }
 
     void update(float deltaTime) override {
@@ -44,34 +45,37 @@ public:
             if (frameTimer >= frameDuration) {
                 frameTimer -= frameDuration;
                 currentFrame = (currentFrame + 1) % totalFrames;
-                sprite.setTextureRect(IntRect(currentFrame * frameWidth, 0, frameWidth, frameHeight));
+                sprite.setTextureRect(getFrameRect(currentFrame));
             }
             sprite.setPosition(x, y);
         }
     }
 
-    void draw(RenderWindow& window, float camera_offset_x) override {
+    void draw(SpriteBatch& batch, float camera_offset_x) const override {
+        if (!isCollected && isVisible) {
+            batch.submit(sprite, x - camera_offset_x, y, LAYER_COLLECTIBLES);
+        }
+    }
+
+    void capture(RenderSnapshot& snapshot) const override {
         if (!isCollected && isVisible) {
-            sprite.setPosition(x - camera_offset_x, y);
-            window.draw(sprite);
+            snapshot.addSprite(sprite, x, y, LAYER_COLLECTIBLES);
         }
     }
 
     void onCollect() override {
         isCollected = true;
         isVisible = false;
-        ringMusic.play();
-        if (scoreManager) scoreManager->addScore(10);
+        AudioManager::getInstance().playSound("Data/Ring.wav", 30);
+        if (scoreManager) {
+            scoreManager->addScore(10);
+            scoreManager->addRing();
+        }
     }
 
     bool checkCollision(float playerX, float playerY, int playerWidth, int playerHeight) override {
         if (isCollected || !isVisible) return false;
-
-        // Use the same AABB collision logic as Spike
-        return (playerX < x + width &&
-                playerX + playerWidth > x &&
-                playerY < y + height &&
-                playerY + playerHeight > y);
+        return boxesOverlap(playerX, playerY, playerWidth, playerHeight, x, y, width, height);
     }
 
     string getType() const override {
@@ -79,13 +83,4 @@ public:
     }
 };
 
-// Static texture definition
-Texture Ring::ringTexture;
-
-// Static variable definitions
-float Ring::frameDuration = 0.1f;
-int Ring::totalFrames = 4;
-int Ring::frameWidth = 16;
-int Ring::frameHeight = 16;
-
 #endif // RING_H 
\ No newline at end of file
@@ -4,11 +4,14 @@
 class ScoreManager {
 private:
     int score;
+    int rings;
 public:
-    ScoreManager() : score(0) {}
+    ScoreManager() : score(0), rings(0) {}
     void addScore(int amount) { score += amount; }
+    void addRing() { rings++; }
     int getScore() const { return score; }
-    void resetScore() { score = 0; }
+    int getRings() const { return rings; }
+    void resetScore() { score = 0; rings = 0; }
 };
 
 #endif // SCORE_MANAGER_H 
\ No newline at end of file
@@ -13,47 +13,32 @@ class Sonic : public Player
 {
 private:
     float originalSpeed;
-    // Single frame textures for different states
-    Texture standingTexture;
-    Texture runningTexture;
-    Texture ballTexture;
-    Texture currentTexture;
-    
+
     // Simple state tracking
     bool facingRight;
     bool isBall;
     
-    bool loadTexture(Texture& texture, const string& filename) {
-        if (!texture.loadFromFile(filename)) {
-            cout << "Failed to load texture: " << filename << endl;
-            return false;
-        }
-        cout << "Successfully loaded texture: " << filename << endl;
-        return true;
-    }
-    
     void updateSprite() {
-        Texture* newTexture = nullptr;
+        AnimationState state;
         
         // Check for max speed (ball form) - priority condition
         if (abs(velocityX) >= max_speed) {
-            newTexture = &ballTexture;
+            state = ANIM_BALL;
             isBall = true;
         }
         // Check for running
         else if (abs(velocityX) > 0) {
-            newTexture = &runningTexture;
+            state = ANIM_RUN;
             isBall = false;
         }
         // Standing still
         else {
-            newTexture = &standingTexture;
+            state = ANIM_STAND;
             isBall = false;
         }
 
-        // Update texture
-        currentTexture = *newTexture;
-        sprite.setTexture(currentTexture);
+        // Only the texture rect changes (see Animation.h)
+        animate(state);
 
         // Update facing direction based on velocity
         if (velocityX > 0) {
@@ -79,20 +64,12 @@ private:
 public:
     Sonic(float start_x, float start_y, HealthManager* healthMgr, float scale = 2.5f) : Player(start_x, start_y, healthMgr, scale) 
     {
-        // Load single frame textures
-        if (!loadTexture(standingTexture, "Data/sonic_standing.png")) {
-            cout << "Error: Could not load standing texture!" << endl;
-        }
-        if (!loadTexture(runningTexture, "Data/sonic_running.png")) {
-            cout << "Error: Could not load running texture!" << endl;
-        }
-        if (!loadTexture(ballTexture, "Data/sonic_ball.png")) {
-            cout << "Error: Could not load ball texture!" << endl;
+        // Load the animation clips (shows the standing frame)
+        if (!animator.load("sonic", sprite)) {
+            cout << "Error: Could not load Sonic's animations!" << endl;
         }
         
-        // Set initial texture and position
-        currentTexture = standingTexture;
-        sprite.setTexture(currentTexture);
+        // Set initial scale
         sprite.setScale(scale_x, scale_y);
         sprite.setOrigin(0, 0);  // Set initial origin
         
@@ -113,9 +90,9 @@ public:
         isBall = false;
     }
 
-    void handleInput(Level* level) override
+    void handleInput(Level* level, const InputState& input) override
     {
-        Player::handleInput(level);
+        Player::handleInput(level, input);
         
         // Update facing direction
         if (velocityX > 0) {
@@ -129,7 +106,7 @@ public:
             }
         }
         
-        if (Keyboard::isKeyPressed(Keyboard::LControl))
+        if (input.isDown(INPUT_ABILITY))
         {
             activateAbility(level);
         }
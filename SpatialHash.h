@@ -0,0 +1,180 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+// Uniform grid over a level's cells for broad-phase collision queries.
+// Items are identified by a small integer id (usually their index in the owner's array)
+// and are listed in every bucket their bounding box overlaps. Rows outside the level
+// are clamped to the border buckets; columns wrap around a power-of-two ring of bucket
+// columns, so a streamed level of any length only needs buckets for its resident window
+// (items far apart can share a bucket, which the exact test filters out).
+// A query only visits the buckets under the query box, so its cost depends on how
+// crowded that part of the level is, not on how long the level is.
+class SpatialHash {
+private:
+    struct Span {
+        int minCol, minRow, maxCol, maxRow;
+        bool active;
+    };
+
+    float cellSize;
+    int columns;      // Bucket columns (a power of two)
+    int columnMask;
+    int rows;
+    vector<vector<int>> buckets;
+    vector<Span> spans;               // Buckets covered by each id
+    vector<unsigned int> queryStamp;  // Per id: last query that returned it (for de-duplication)
+    unsigned int currentStamp;
+    int itemCount;
+
+    // Unwrapped column; kept in a range where int arithmetic can't overflow
+    int columnOf(float x) const {
+        float col = floor(x / cellSize);
+        if (!(col > -1.0e8f)) return -100000000;
+        return col > 1.0e8f ? 100000000 : static_cast<int>(col);
+    }
+
+    int clampRow(float y) const {
+        int row = static_cast<int>(y / cellSize);
+        if (y < 0 || row < 0) return 0;
+        return row >= rows ? rows - 1 : row;
+    }
+
+    Span spanFor(float x, float y, float w, float h) const {
+        Span span;
+        span.minCol = columnOf(x);
+        span.minRow = clampRow(y);
+        span.maxCol = columnOf(x + w);
+        span.maxRow = clampRow(y + h);
+        // Wider than the ring: every bucket column is covered once
+        if (span.maxCol - span.minCol >= columns) span.maxCol = span.minCol + columns - 1;
+        span.active = true;
+        return span;
+    }
+
+    void addToBuckets(int id, const Span& span) {
+        for (int row = span.minRow; row <= span.maxRow; row++) {
+            for (int col = span.minCol; col <= span.maxCol; col++) {
+                buckets[row * columns + (col & columnMask)].push_back(id);
+            }
+        }
+    }
+
+    void removeFromBuckets(int id, const Span& span) {
+        for (int row = span.minRow; row <= span.maxRow; row++) {
+            for (int col = span.minCol; col <= span.maxCol; col++) {
+                vector<int>& bucket = buckets[row * columns + (col & columnMask)];
+                for (size_t i = 0; i < bucket.size(); i++) {
+                    if (bucket[i] == id) {
+                        bucket[i] = bucket.back();
+                        bucket.pop_back();
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+public:
+    SpatialHash() : cellSize(1.0f), columns(0), columnMask(0), rows(0), currentStamp(0), itemCount(0) {}
+
+    // Size the grid and drop everything in it. levelColumns is the number of columns
+    // items can spread over at once: the whole level, or a streamed level's window.
+    void reset(int levelColumns, int levelRows, float levelCellSize) {
+        cellSize = levelCellSize > 0 ? levelCellSize : 1.0f;
+        columns = 1;
+        while (columns < levelColumns) columns <<= 1;
+        columnMask = columns - 1;
+        rows = levelRows > 0 ? levelRows : 1;
+        buckets.assign(columns * rows, vector<int>());
+        spans.clear();
+        queryStamp.clear();
+        currentStamp = 0;
+        itemCount = 0;
+    }
+
+    // Drop every item but keep the grid size (and bucket capacity)
+    void clear() {
+        for (size_t i = 0; i < buckets.size(); i++) {
+            buckets[i].clear();
+        }
+        spans.clear();
+        queryStamp.clear();
+        itemCount = 0;
+    }
+
+    // Insert an item, or move it if it is already in the grid.
+    // Moving only touches the buckets when the item crosses a cell boundary.
+    void update(int id, float x, float y, float w, float h) {
+        if (id < 0 || buckets.empty()) return;
+        if (id >= static_cast<int>(spans.size())) {
+            Span empty = { 0, 0, -1, -1, false };
+            spans.resize(id + 1, empty);
+            queryStamp.resize(id + 1, 0);
+        }
+
+        Span span = spanFor(x, y, w, h);
+        Span& current = spans[id];
+        if (current.active) {
+            if (current.minCol == span.minCol && current.minRow == span.minRow &&
+                current.maxCol == span.maxCol && current.maxRow == span.maxRow) {
+                return;
+            }
+            removeFromBuckets(id, current);
+        }
+        else {
+            itemCount++;
+        }
+        addToBuckets(id, span);
+        current = span;
+    }
+
+    void insert(int id, float x, float y, float w, float h) {
+        update(id, x, y, w, h);
+    }
+
+    void remove(int id) {
+        if (!contains(id)) return;
+        removeFromBuckets(id, spans[id]);
+        spans[id].active = false;
+        itemCount--;
+    }
+
+    bool contains(int id) const {
+        return id >= 0 && id < static_cast<int>(spans.size()) && spans[id].active;
+    }
+
+    // Append to 'out' the id of every item sharing a bucket with the box, each once.
+    // Callers still do the exact overlap test.
+    void query(float x, float y, float w, float h, vector<int>& out) {
+        if (buckets.empty() || itemCount == 0) return;
+
+        if (++currentStamp == 0) {
+            // Stamp counter wrapped - forget old stamps so nothing is skipped by mistake
+            for (size_t i = 0; i < queryStamp.size(); i++) queryStamp[i] = 0;
+            currentStamp = 1;
+        }
+
+        Span span = spanFor(x, y, w, h);
+        for (int row = span.minRow; row <= span.maxRow; row++) {
+            for (int col = span.minCol; col <= span.maxCol; col++) {
+                const vector<int>& bucket = buckets[row * columns + (col & columnMask)];
+                for (size_t i = 0; i < bucket.size(); i++) {
+                    int id = bucket[i];
+                    if (queryStamp[id] != currentStamp) {
+                        queryStamp[id] = currentStamp;
+                        out.push_back(id);
+                    }
+                }
+            }
+        }
+    }
+
+    int getItemCount() const { return itemCount; }
+};
+
+#endif // SPATIAL_HASH_H
@@ -5,30 +5,31 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <cmath>
+#include <algorithm>
 
 using namespace sf;
 
 class SpecialBoost : public Collectible {
 private:
-    static Texture boostTexture;
+    TextureRegion boostTexture;
     Sprite sprite;
     float hoverTimer;
     float baseY;
-    static float hoverAmplitude; // pixels
-    static float hoverSpeed; // radians/sec
-    static int frameWidth;
-    static int frameHeight;
+    static inline float hoverAmplitude = 8.0f; // pixels
+    static inline float hoverSpeed = 2.0f; // radians/sec
+    static inline int frameWidth = 32;
+    static inline int frameHeight = 32;
 
 public:
     SpecialBoost(float startX, float startY, float scale = 2.0f)
         : Collectible(startX, startY, scale), hoverTimer(0.0f), baseY(startY) {
         width = frameWidth * scale;
         height = frameHeight * scale;
-        if (boostTexture.getSize().x == 0) {
-            boostTexture.loadFromFile("Data/special_boost.png");
-        }
-        sprite.setTexture(boostTexture);
-        sprite.setTextureRect(IntRect(0, 0, frameWidth, frameHeight));
+        TextureCache::getInstance().acquireRegion("Data/special_boost.png", boostTexture);
+        sprite.setTexture(*boostTexture.texture);
+        // Never sample past the image - on an atlas page that would pick up the neighbours
+        sprite.setTextureRect(IntRect(boostTexture.rect.left, boostTexture.rect.top,
+            std::min(frameWidth, boostTexture.rect.width), std::min(frameHeight, boostTexture.rect.height)));
         sprite.setScale(scale, scale);
         sprite.setPosition(x, y);
     }
@@ -41,10 +42,15 @@ public:
         }
     }
 
-    void draw(RenderWindow& window, float camera_offset_x) override {
+    void draw(SpriteBatch& batch, float camera_offset_x) const override {
         if (!isCollected && isVisible) {
-            sprite.setPosition(x - camera_offset_x, sprite.getPosition().y);
-            window.draw(sprite);
+            batch.submit(sprite, x - camera_offset_x, sprite.getPosition().y, LAYER_COLLECTIBLES);
+        }
+    }
+
+    void capture(RenderSnapshot& snapshot) const override {
+        if (!isCollected && isVisible) {
+            snapshot.addSprite(sprite, x, sprite.getPosition().y, LAYER_COLLECTIBLES);
         }
     }
 
@@ -56,10 +62,7 @@ public:
 
     bool checkCollision(float playerX, float playerY, int playerWidth, int playerHeight) override {
         if (isCollected || !isVisible) return false;
-        return (playerX < x + width &&
-                playerX + playerWidth > x &&
-                playerY < y + height &&
-                playerY + playerHeight > y);
+        return boxesOverlap(playerX, playerY, playerWidth, playerHeight, x, y, width, height);
     }
 
     string getType() const override {
@@ -67,13 +70,4 @@ public:
     }
 };
 
-// Static texture definition
-Texture SpecialBoost::boostTexture;
-
-// Static variable definitions
-float SpecialBoost::hoverAmplitude = 8.0f;
-float SpecialBoost::hoverSpeed = 2.0f;
-int SpecialBoost::frameWidth = 32;
-int SpecialBoost::frameHeight = 32;
-
 #endif // SPECIALBOOST_H 
\ No newline at end of file
@@ -1,25 +1,27 @@
 #pragma once
 #include "Obstacle.h"
 #include <SFML/Graphics.hpp>
+#include "TextureCache.h"
 
 class Spike : public Obstacle {
 private:
-    sf::Texture spikeTexture;
+    TextureRegion spikeTexture;
     sf::Sprite spikeSprite;
-    const float DAMAGE = 1.0f;  // Damage dealt to player when hit
+    static constexpr float DAMAGE = 1.0f;  // Damage dealt to player when hit
 
 public:
     Spike(float x, float y, float size) : Obstacle(x, y, size, size) {
         // Load spike texture
-        if (!spikeTexture.loadFromFile("Data/spike.png")) {
+        if (!TextureCache::getInstance().acquireRegion("Data/spike.png", spikeTexture)) {
             std::cout << "Failed to load spike texture" << std::endl;
         }
-        spikeSprite.setTexture(spikeTexture);
+        spikeSprite.setTexture(*spikeTexture.texture);
+        spikeSprite.setTextureRect(spikeTexture.rect);
         
         // Scale sprite to match cell size
         spikeSprite.setScale(
-            static_cast<float>(size) / spikeTexture.getSize().x,
-            static_cast<float>(size) / spikeTexture.getSize().y
+            static_cast<float>(size) / spikeTexture.rect.width,
+            static_cast<float>(size) / spikeTexture.rect.height
         );
     }
 
@@ -27,17 +29,16 @@ public:
         // Spikes don't need any update logic
     }
 
-    void draw(sf::RenderWindow& window, float camera_offset_x) override {
-        spikeSprite.setPosition(x - camera_offset_x, y);
-        window.draw(spikeSprite);
+    void draw(SpriteBatch& batch, float camera_offset_x) const override {
+        batch.submit(spikeSprite, x - camera_offset_x, y, LAYER_OBSTACLES);
+    }
+
+    void capture(RenderSnapshot& snapshot) const override {
+        snapshot.addSprite(spikeSprite, x, y, LAYER_OBSTACLES);
     }
 
     bool checkCollision(float playerX, float playerY, float playerWidth, float playerHeight) override {
-        // Simple collision check
-        return (playerX < x + width &&
-                playerX + playerWidth > x &&
-                playerY < y + height &&
-                playerY + playerHeight > y);
+        return boxesOverlap(playerX, playerY, playerWidth, playerHeight, x, y, width, height);
     }
 
     float getDamage() const { return DAMAGE; }
@@ -0,0 +1,100 @@
+#ifndef SPRITE_ATLAS_H
+#define SPRITE_ATLAS_H
+
+#include <SFML/Graphics.hpp>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace sf;
+using namespace std;
+
+// Runtime side of the packed sprite atlas.
+// The manifest is generated by tools/AtlasPacker.cpp and maps each original image path
+// (e.g. "Data/spike.png") to a sub-rectangle of one of the atlas pages:
+//
+//   page <index> <page image path>
+//   sprite <original image path> <page index> <left> <top> <width> <height>
+class SpriteAtlas {
+private:
+    struct Entry {
+        int page;
+        IntRect rect;
+    };
+
+    vector<string> pages;
+    map<string, Entry> entries;
+    bool loaded;
+
+public:
+    SpriteAtlas() : loaded(false) {}
+
+    bool loadManifest(const string& filename) {
+        pages.clear();
+        entries.clear();
+        loaded = false;
+
+        ifstream file(filename);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        string line;
+        while (getline(file, line)) {
+            if (line.empty() || line[0] == '#') continue;
+
+            istringstream in(line);
+            string kind;
+            in >> kind;
+            if (kind == "page") {
+                int index;
+                string path;
+                if (in >> index >> path && index >= 0) {
+                    if (index >= static_cast<int>(pages.size())) pages.resize(index + 1);
+                    pages[index] = path;
+                }
+            }
+            else if (kind == "sprite") {
+                string name;
+                Entry entry;
+                if (in >> name >> entry.page >> entry.rect.left >> entry.rect.top >> entry.rect.width >> entry.rect.height) {
+                    entries[name] = entry;
+                }
+            }
+        }
+
+        // Drop sprites that point at pages the manifest never declared
+        for (map<string, Entry>::iterator it = entries.begin(); it != entries.end();) {
+            if (it->second.page < 0 || it->second.page >= static_cast<int>(pages.size()) || pages[it->second.page].empty()) {
+                it = entries.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+
+        loaded = !entries.empty();
+        if (loaded) {
+            cout << "Loaded sprite atlas: " << entries.size() << " sprites on " << pages.size() << " page(s)" << endl;
+        }
+        return loaded;
+    }
+
+    // Look up the atlas page and sub-rectangle for an original image path
+    bool find(const string& name, string& pagePath, IntRect& rect) const {
+        map<string, Entry>::const_iterator it = entries.find(name);
+        if (it == entries.end()) return false;
+        pagePath = pages[it->second.page];
+        rect = it->second.rect;
+        return true;
+    }
+
+    bool isLoaded() const { return loaded; }
+    int getPageCount() const { return static_cast<int>(pages.size()); }
+    int getSpriteCount() const { return static_cast<int>(entries.size()); }
+};
+
+#endif // SPRITE_ATLAS_H
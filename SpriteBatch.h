@@ -0,0 +1,135 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace sf;
+using namespace std;
+
+// What a sprite is drawn over, back to front
+enum DrawLayer {
+    LAYER_OBSTACLES = 0,
+    LAYER_COLLECTIBLES,
+    LAYER_ENEMIES,
+    LAYER_SHOTS,
+    LAYER_PLAYERS,
+    LAYER_COUNT
+};
+
+// One sprite waiting in a SpriteBatch, in screen coordinates
+struct BatchQuad {
+    const Texture* texture;     // nullptr: a plain coloured rectangle
+    IntRect rect;
+    Vector2f position;          // Top left
+    Vector2f size;
+    Color color;
+    bool flipX;                 // Mirror the texture rect horizontally
+};
+
+// Collects the frame's sprites instead of drawing them one by one. flush() sorts
+// them by (layer, texture) and draws each run sharing both with one vertex array,
+// so a frame costs one draw call per texture per layer however many sprites there
+// are. Within a run sprites keep the order they were submitted in.
+class SpriteBatch {
+private:
+    vector<BatchQuad> quads;
+    vector<const Texture*> textures;    // Textures seen since the last flush, by slot
+    vector<uint64_t> keys;              // layer | texture slot | submission index
+    VertexArray vertices;
+    int drawCalls;
+    int vertexCount;
+
+    static const int SLOT_SHIFT = 32;
+    static const int LAYER_SHIFT = 48;
+
+    int slotOf(const Texture* texture) {
+        for (size_t i = 0; i < textures.size(); i++) {
+            if (textures[i] == texture) return static_cast<int>(i);
+        }
+        textures.push_back(texture);
+        return static_cast<int>(textures.size()) - 1;
+    }
+
+    void appendQuad(const BatchQuad& quad) {
+        float left = quad.position.x, top = quad.position.y;
+        float right = left + quad.size.x, bottom = top + quad.size.y;
+        float u1 = static_cast<float>(quad.rect.left);
+        float u2 = u1 + quad.rect.width;
+        if (quad.flipX) swap(u1, u2);
+        float v1 = static_cast<float>(quad.rect.top);
+        float v2 = v1 + quad.rect.height;
+        vertices.append(Vertex(Vector2f(left, top), quad.color, Vector2f(u1, v1)));
+        vertices.append(Vertex(Vector2f(right, top), quad.color, Vector2f(u2, v1)));
+        vertices.append(Vertex(Vector2f(right, bottom), quad.color, Vector2f(u2, v2)));
+        vertices.append(Vertex(Vector2f(left, bottom), quad.color, Vector2f(u1, v2)));
+    }
+
+public:
+    SpriteBatch() : vertices(Quads), drawCalls(0), vertexCount(0) {}
+
+    void submit(const Texture* texture, const IntRect& rect, Vector2f position, Vector2f size, Color color, bool flipX, int layer) {
+        BatchQuad quad;
+        quad.texture = texture;
+        quad.rect = rect;
+        quad.position = position;
+        quad.size = size;
+        quad.color = color;
+        quad.flipX = flipX;
+        keys.push_back((static_cast<uint64_t>(layer) << LAYER_SHIFT) |
+                       (static_cast<uint64_t>(slotOf(texture)) << SLOT_SHIFT) | quads.size());
+        quads.push_back(quad);
+    }
+
+    // A sprite as sf::Sprite would draw it at (x, y) with its rect, scale, origin and
+    // colour (no rotation). A negative x scale mirrors it, as the characters use.
+    void submit(const Texture* texture, const IntRect& rect, float x, float y, Vector2f origin, Vector2f scale, Color color, int layer) {
+        float left = x - origin.x * scale.x;
+        float top = y - origin.y * scale.y;
+        float width = rect.width * scale.x;
+        float height = rect.height * scale.y;
+        if (width < 0) left += width;
+        submit(texture, rect, Vector2f(left, top), Vector2f(fabs(width), height), color, width < 0, layer);
+    }
+
+    void submit(const Sprite& sprite, float x, float y, int layer) {
+        submit(sprite.getTexture(), sprite.getTextureRect(), x, y, sprite.getOrigin(), sprite.getScale(), sprite.getColor(), layer);
+    }
+
+    // An untextured rectangle
+    void submitRect(float x, float y, Vector2f size, Color color, int layer) {
+        submit(nullptr, IntRect(), Vector2f(x, y), size, color, false, layer);
+    }
+
+    // Draw everything submitted since the last flush and start over
+    void flush(RenderTarget& target) {
+        sort(keys.begin(), keys.end());
+        drawCalls = 0;
+        vertexCount = 0;
+        RenderStates states;
+        size_t n = 0;
+        while (n < keys.size()) {
+            uint64_t run = keys[n] >> SLOT_SHIFT;
+            vertices.clear();
+            for (; n < keys.size() && (keys[n] >> SLOT_SHIFT) == run; n++) {
+                appendQuad(quads[keys[n] & 0xFFFFFFFFu]);
+            }
+            states.texture = textures[run & 0xFFFF];
+            target.draw(vertices, states);
+            drawCalls++;
+            vertexCount += static_cast<int>(vertices.getVertexCount());
+        }
+        quads.clear();
+        textures.clear();
+        keys.clear();
+    }
+
+    // Of the last flush
+    int getDrawCalls() const { return drawCalls; }
+    int getVertexCount() const { return vertexCount; }
+};
+
+#endif // SPRITE_BATCH_H
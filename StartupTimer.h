@@ -0,0 +1,45 @@
+#ifndef STARTUP_TIMER_H
+#define STARTUP_TIMER_H
+
+#include <chrono>
+#include <iostream>
+#include "Trace.h"
+
+using namespace std;
+
+// Launch milestones, timed from process start (static initialisation, just before main):
+//   first frame  - the first frame on screen (the intro's)
+//   interactive  - the menu has drawn and accepts input
+// Each is printed once, and marked in the session trace.
+class StartupTimer {
+private:
+    typedef chrono::steady_clock StartupClock;
+
+    inline static const StartupClock::time_point processStart = StartupClock::now();
+    inline static bool firstFrameMarked = false;
+    inline static bool interactiveMarked = false;
+
+    static void report(const char* milestone) {
+        cout << "[Startup] " << milestone << ": " << getElapsedMs() << " ms" << endl;
+        TRACE_INSTANT("startup", milestone);
+    }
+
+public:
+    static float getElapsedMs() {
+        return chrono::duration<float, milli>(StartupClock::now() - processStart).count();
+    }
+
+    static void markFirstFrame() {
+        if (firstFrameMarked) return;
+        firstFrameMarked = true;
+        report("first frame");
+    }
+
+    static void markInteractive() {
+        if (interactiveMarked) return;
+        interactiveMarked = true;
+        report("interactive");
+    }
+};
+
+#endif // STARTUP_TIMER_H
@@ -23,50 +23,35 @@ private:
     bool hasReachedTargetHeight;
     const float FLIGHT_VERTICAL_SPEED = 8.0f;  // Speed for W/S controls
 
-    // Textures for different states
-    Texture standingTexture;
-    Texture runningTexture;
-    Texture flyingTexture;
-    Texture ballTexture;
-    Texture currentTexture;
     bool facingRight;
     bool isBall;
 
-
-    bool loadTexture(Texture& texture, const string& filename) {
-        if (!texture.loadFromFile(filename)) {
-            return false;
-        }
-        return true;
-    }
-
     void updateSprite() {
-        Texture* newTexture = nullptr;
+        AnimationState state;
 
         // Check for flying first - highest priority when in flight mode
         if (isFlying) {
-            newTexture = &flyingTexture;
+            state = ANIM_FLY;
             isBall = false;
         }
         // Check for max speed (ball form)
         else if (abs(velocityX) >= max_speed) {
-            newTexture = &ballTexture;
+            state = ANIM_BALL;
             isBall = true;
         }
         // Check for running
         else if (abs(velocityX) > 0) {
-            newTexture = &runningTexture;
+            state = ANIM_RUN;
             isBall = false;
         }
         // Standing still
         else {
-            newTexture = &standingTexture;
+            state = ANIM_STAND;
             isBall = false;
         }
 
-        // Update texture
-        currentTexture = *newTexture;
-        sprite.setTexture(currentTexture);
+        // Only the texture rect changes (see Animation.h)
+        animate(state);
 
         // Update facing direction based on velocity
         if (velocityX > 0) {
@@ -91,17 +76,14 @@ private:
     }
 
 public:
+    float getFlightTimeRemaining() const { return flightTimeRemaining; }
+
     Tails(float start_x, float start_y, HealthManager* healthMgr, float scale = 2.5f) : Player(start_x, start_y, healthMgr, scale)
     {
-        // Load textures
-        loadTexture(standingTexture, "Data/tails_standing.png");
-        loadTexture(runningTexture, "Data/tails_running.png");
-        loadTexture(flyingTexture, "Data/tails_flying.png");
-        loadTexture(ballTexture, "Data/tails_ball.png");
+        // Load the animation clips (shows the standing frame)
+        animator.load("tails", sprite);
         
-        // Set initial texture
-        currentTexture = standingTexture;
-        sprite.setTexture(currentTexture);
+        // Set initial scale
         sprite.setScale(scale_x, scale_y);
         sprite.setOrigin(0, 0);
         
@@ -125,9 +107,9 @@ public:
         isBall = false;
     }
 
-    void handleInput(Level* level) override
+    void handleInput(Level* level, const InputState& input) override
     {
-        Player::handleInput(level);
+        Player::handleInput(level, input);
         
         // Update facing direction
         if (velocityX > 0) {
@@ -143,10 +125,10 @@ public:
         
         // Flight controls
         if (isFlying) {
-            if (Keyboard::isKeyPressed(Keyboard::W)) {
+            if (input.isDown(INPUT_UP)) {
                 velocityY = -FLIGHT_VERTICAL_SPEED;  // Move up
             }
-            else if (Keyboard::isKeyPressed(Keyboard::S)) {
+            else if (input.isDown(INPUT_DOWN)) {
                 velocityY = FLIGHT_VERTICAL_SPEED;   // Move down
             }
             else {
@@ -154,7 +136,7 @@ public:
             }
         }
         
-        if (Keyboard::isKeyPressed(Keyboard::LControl))
+        if (input.isDown(INPUT_ABILITY))
         {
             activateAbility(level);
         }
@@ -168,7 +150,7 @@ public:
         else {
             // Custom flight physics
             float offset_y = player_y;
-            offset_y += velocityY;
+            offset_y += velocityY * PHYSICS_STEP;
 
             // Check for ground collision
             int cell_size = static_cast<int>(level->getCellSize());
@@ -183,11 +165,12 @@ public:
                 mid_col >= 0 && mid_col < level->getWidth() &&
                 right_col >= 0 && right_col < level->getWidth()) {
                 
-                char bottom_left_down = level->getLevelData()[bottom_row][left_col];
-                char bottom_mid_down = level->getLevelData()[bottom_row][mid_col];
-                char bottom_right_down = level->getLevelData()[bottom_row][right_col];
+                const TileGrid& tiles = level->getTiles();
+                TileType bottom_left_down = tiles.get(left_col, bottom_row);
+                TileType bottom_mid_down = tiles.get(mid_col, bottom_row);
+                TileType bottom_right_down = tiles.get(right_col, bottom_row);
 
-            if (bottom_left_down == 'w' || bottom_mid_down == 'w' || bottom_right_down == 'w') {
+            if (bottom_left_down == TILE_WALL || bottom_mid_down == TILE_WALL || bottom_right_down == TILE_WALL) {
                 onGround = true;
                 endFlight();
             }
@@ -198,7 +181,7 @@ public:
             }
 
             // Apply horizontal movement
-            player_x += velocityX;
+            player_x += velocityX * PHYSICS_STEP;
         }
         updateSprite();
     }
@@ -0,0 +1,213 @@
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "SpriteAtlas.h"
+#include "Trace.h"
+
+using namespace sf;
+using namespace std;
+
+// Shared, reference-counted handle to a cached texture
+typedef shared_ptr<Texture> TextureHandle;
+
+// A texture plus the part of it that holds one image - either a whole standalone
+// texture or a sub-rectangle of a packed atlas page
+struct TextureRegion {
+    TextureHandle texture;
+    IntRect rect;
+};
+
+static const char* const ATLAS_MANIFEST_PATH = "Data/atlas/atlas.txt";
+
+// Process-wide texture cache: every image file is decoded and uploaded once, no matter
+// how many entities use it. The cache only holds weak references, so a texture is freed
+// as soon as the last handle to it goes away. In threaded mode both the simulation and
+// the render thread use it, so every call takes the cache's lock.
+class TextureCache {
+private:
+    struct Entry {
+        weak_ptr<Texture> texture;
+        size_t bytes;      // Approximate GPU memory (RGBA8)
+        bool failed;       // File could not be loaded - don't retry on every request
+    };
+
+    map<string, Entry> entries;
+    unsigned long long hits;
+    unsigned long long misses;
+    SpriteAtlas atlas;
+    bool atlasChecked;
+    bool loadingEnabled;
+    mutable recursive_mutex lock;      // Recursive: acquireRegion and printStats call other members
+
+    TextureCache() : hits(0), misses(0), atlasChecked(false), loadingEnabled(true) {}
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    static size_t textureBytes(const Texture& texture) {
+        return static_cast<size_t>(texture.getSize().x) * texture.getSize().y * 4;
+    }
+
+    void loadAtlasManifest() {
+        if (!atlasChecked && loadingEnabled) {
+            atlas.loadManifest(ATLAS_MANIFEST_PATH);
+            atlasChecked = true;
+        }
+    }
+
+public:
+    static TextureCache& getInstance() {
+        static TextureCache instance;
+        return instance;
+    }
+
+    // Get a handle to the texture for a file, loading it on first use.
+    // 'out' always receives a valid texture (empty if loading failed).
+    bool acquire(const string& filename, TextureHandle& out) {
+        lock_guard<recursive_mutex> guard(lock);
+        map<string, Entry>::iterator it = entries.find(filename);
+        if (it != entries.end()) {
+            TextureHandle existing = it->second.texture.lock();
+            if (existing) {
+                hits++;
+                out = existing;
+                return !it->second.failed;
+            }
+        }
+
+        misses++;
+        TRACE_SCOPE_DETAIL("load", "texture", filename.c_str());
+        TextureHandle texture = make_shared<Texture>();
+        bool loaded = loadingEnabled ? texture->loadFromFile(filename) : true;
+
+        Entry& entry = entries[filename];
+        entry.texture = texture;
+        entry.bytes = textureBytes(*texture);
+        entry.failed = !loaded;
+        out = texture;
+        return loaded;
+    }
+
+    // Convenience overload for callers that don't care about failure
+    TextureHandle acquire(const string& filename) {
+        TextureHandle texture;
+        acquire(filename, texture);
+        return texture;
+    }
+
+    // Get the region for an image, resolving it to a packed atlas page when the atlas
+    // manifest lists it and falling back to the standalone file otherwise
+    bool acquireRegion(const string& filename, TextureRegion& out) {
+        lock_guard<recursive_mutex> guard(lock);
+        loadAtlasManifest();
+
+        string pagePath;
+        IntRect rect;
+        if (atlas.find(filename, pagePath, rect) && acquire(pagePath, out.texture)) {
+            out.rect = rect;
+            return true;
+        }
+
+        bool loaded = acquire(filename, out.texture);
+        out.rect = IntRect(0, 0, out.texture->getSize().x, out.texture->getSize().y);
+        return loaded;
+    }
+
+    const SpriteAtlas& getAtlas() const { return atlas; }
+
+    // The file acquireRegion would load for an image: its atlas page, or the image itself
+    string resolveFile(const string& filename) {
+        lock_guard<recursive_mutex> guard(lock);
+        loadAtlasManifest();
+        string pagePath;
+        IntRect rect;
+        return atlas.find(filename, pagePath, rect) ? pagePath : filename;
+    }
+
+    bool isResident(const string& filename) const {
+        lock_guard<recursive_mutex> guard(lock);
+        map<string, Entry>::const_iterator it = entries.find(filename);
+        return it != entries.end() && !it->second.texture.expired();
+    }
+
+    // Hand the cache a texture uploaded elsewhere (ZoneLoader decodes and uploads ahead
+    // of time); later acquires of the file hit it for as long as someone holds a handle
+    void adopt(const string& filename, const TextureHandle& texture, bool loaded) {
+        lock_guard<recursive_mutex> guard(lock);
+        misses++;
+        Entry& entry = entries[filename];
+        entry.texture = texture;
+        entry.bytes = textureBytes(*texture);
+        entry.failed = !loaded;
+    }
+
+    // Headless runs have no GPU context: hand out empty textures without touching
+    // the disk and report them as loaded, so the game world is built exactly the same
+    void setLoadingEnabled(bool enabled) { loadingEnabled = enabled; }
+    bool isLoadingEnabled() const { return loadingEnabled; }
+
+    // Drop entries whose textures have been released
+    void purge() {
+        lock_guard<recursive_mutex> guard(lock);
+        for (map<string, Entry>::iterator it = entries.begin(); it != entries.end();) {
+            if (it->second.texture.expired()) {
+                it = entries.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    // Statistics
+    unsigned long long getHits() const {
+        lock_guard<recursive_mutex> guard(lock);
+        return hits;
+    }
+    unsigned long long getMisses() const {
+        lock_guard<recursive_mutex> guard(lock);
+        return misses;
+    }
+
+    size_t getBytesResident() const {
+        lock_guard<recursive_mutex> guard(lock);
+        size_t total = 0;
+        for (map<string, Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it) {
+            if (!it->second.texture.expired()) total += it->second.bytes;
+        }
+        return total;
+    }
+
+    // Handles to every texture still in use, so the caller can keep them alive
+    void collectResident(vector<TextureHandle>& out) const {
+        lock_guard<recursive_mutex> guard(lock);
+        for (map<string, Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it) {
+            TextureHandle texture = it->second.texture.lock();
+            if (texture) out.push_back(texture);
+        }
+    }
+
+    int getResidentCount() const {
+        lock_guard<recursive_mutex> guard(lock);
+        int count = 0;
+        for (map<string, Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it) {
+            if (!it->second.texture.expired()) count++;
+        }
+        return count;
+    }
+
+    void printStats() const {
+        lock_guard<recursive_mutex> guard(lock);
+        cout << "[TextureCache] textures: " << getResidentCount()
+             << ", hits: " << hits
+             << ", misses: " << misses
+             << ", resident: " << (getBytesResident() / 1024) << " KB" << endl;
+    }
+};
+
+#endif // TEXTURE_CACHE_H
@@ -0,0 +1,160 @@
+#ifndef TILE_GRID_H
+#define TILE_GRID_H
+
+#include <vector>
+
+using namespace std;
+
+// What occupies a level cell
+enum TileType {
+    TILE_EMPTY = 0,
+    TILE_WALL,
+    TILE_PLATFORM,
+    TILE_BREAKABLE,
+    TILE_SPIKE,
+    TILE_RING,
+    TILE_EXTRA_LIFE,
+    TILE_SPECIAL_BOOST,
+    TILE_TYPE_COUNT
+};
+
+// Behaviour bits derived from the tile type
+enum TileFlag {
+    TILE_FLAG_SOLID = 1 << 0,      // Blocks movement from every side
+    TILE_FLAG_ONE_WAY = 1 << 1,    // Only blocks from above (platforms)
+    TILE_FLAG_HAZARD = 1 << 2,     // Hurts on contact
+    TILE_FLAG_BREAKABLE = 1 << 3   // Knuckles can punch through it
+};
+
+// Level tiles in one contiguous, column-major buffer: all rows of a column sit next
+// to each other, so the column ranges that scrolling, drawing and collision work on
+// are a single linear run of memory. Each byte holds the tile type in the low four
+// bits and its flags in the high four, so flag tests need no table lookup.
+//
+// Storage is a ring of a power-of-two number of columns, addressed by column & mask.
+// A fully loaded level stores every column; a streamed level stores a fixed window
+// and marks which columns are resident (see Level's streaming mode).
+// Reads outside the grid or outside the resident columns return TILE_EMPTY.
+class TileGrid {
+private:
+    vector<unsigned char> cells;
+    int columns;         // Level width
+    int rows;
+    int columnMask;      // Stored columns - 1
+    int firstResident;   // Columns that currently hold valid data
+    int lastResident;
+
+    static unsigned char flagsFor(TileType type) {
+        switch (type) {
+            case TILE_WALL: return TILE_FLAG_SOLID;
+            case TILE_PLATFORM: return TILE_FLAG_ONE_WAY;
+            case TILE_BREAKABLE: return TILE_FLAG_SOLID | TILE_FLAG_BREAKABLE;
+            case TILE_SPIKE: return TILE_FLAG_HAZARD;
+            default: return 0;
+        }
+    }
+
+    static unsigned char encode(TileType type) {
+        return static_cast<unsigned char>(type | (flagsFor(type) << 4));
+    }
+
+    int index(int col, int row) const { return (col & columnMask) * rows + row; }
+
+public:
+    TileGrid() : columns(0), rows(0), columnMask(0), firstResident(0), lastResident(-1) {}
+
+    // Resize and clear every cell to empty.
+    // windowColumns = 0 stores the whole level; otherwise only that many columns
+    // (rounded up to a power of two) are stored and none are resident yet.
+    void resize(int width, int height, int windowColumns = 0) {
+        columns = width > 0 ? width : 0;
+        rows = height > 0 ? height : 0;
+        bool windowed = windowColumns > 0 && windowColumns < columns;
+        int stored = 1;
+        while (stored < (windowed ? windowColumns : columns)) stored <<= 1;
+        columnMask = stored - 1;
+        cells.assign(static_cast<size_t>(stored) * rows, encode(TILE_EMPTY));
+        firstResident = 0;
+        lastResident = windowed ? -1 : columns - 1;
+    }
+
+    void fill(TileType type) {
+        cells.assign(cells.size(), encode(type));
+    }
+
+    // Mark the columns [first, last] as holding valid data. The range must fit in
+    // the stored window; columns newly entering it must be cleared and filled by the caller.
+    bool setResidentColumns(int first, int last) {
+        if (first < 0 || last >= columns || last - first > columnMask) return false;
+        firstResident = first;
+        lastResident = last;
+        return true;
+    }
+
+    void clearColumn(int col) {
+        if (col < 0 || col >= columns) return;
+        for (int row = 0; row < rows; row++) {
+            cells[index(col, row)] = encode(TILE_EMPTY);
+        }
+    }
+
+    bool isResident(int col) const { return col >= firstResident && col <= lastResident; }
+    int getFirstResident() const { return firstResident; }
+    int getLastResident() const { return lastResident; }
+    int getStoredColumns() const { return columnMask + 1; }
+
+    bool inBounds(int col, int row) const {
+        return isResident(col) && row >= 0 && row < rows;
+    }
+
+    TileType get(int col, int row) const {
+        if (!inBounds(col, row)) return TILE_EMPTY;
+        return static_cast<TileType>(cells[index(col, row)] & 0x0F);
+    }
+
+    unsigned char flags(int col, int row) const {
+        if (!inBounds(col, row)) return 0;
+        return cells[index(col, row)] >> 4;
+    }
+
+    bool hasFlag(int col, int row, TileFlag flag) const {
+        return (flags(col, row) & flag) != 0;
+    }
+
+    bool isSolid(int col, int row) const { return hasFlag(col, row, TILE_FLAG_SOLID); }
+    bool isOneWay(int col, int row) const { return hasFlag(col, row, TILE_FLAG_ONE_WAY); }
+
+    void set(int col, int row, TileType type) {
+        if (inBounds(col, row)) {
+            cells[index(col, row)] = encode(type);
+        }
+    }
+
+    // Raw encoded cells of one resident column (rows entries); decode with typeOf()
+    const unsigned char* column(int col) const { return &cells[index(col, 0)]; }
+    static TileType typeOf(unsigned char cell) { return static_cast<TileType>(cell & 0x0F); }
+
+    int getWidth() const { return columns; }
+    int getHeight() const { return rows; }
+
+    // Layout file characters
+    static TileType fromChar(char c) {
+        switch (c) {
+            case 'w': return TILE_WALL;
+            case 'p': return TILE_PLATFORM;
+            case 'b': return TILE_BREAKABLE;
+            case 'o': return TILE_SPIKE;
+            case 'r': return TILE_RING;
+            case 'l': return TILE_EXTRA_LIFE;
+            case 'z': return TILE_SPECIAL_BOOST;
+            default: return TILE_EMPTY;  // 's' and anything unknown
+        }
+    }
+
+    static char toChar(TileType type) {
+        static const char chars[TILE_TYPE_COUNT] = { 's', 'w', 'p', 'b', 'o', 'r', 'l', 'z' };
+        return (type >= 0 && type < TILE_TYPE_COUNT) ? chars[type] : 's';
+    }
+};
+
+#endif // TILE_GRID_H
@@ -0,0 +1,214 @@
+#ifndef TILE_MAP_RENDERER_H
+#define TILE_MAP_RENDERER_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "TextureCache.h"
+#include "TileGrid.h"
+#include "RenderSnapshot.h"
+
+using namespace sf;
+using namespace std;
+
+// Batched renderer for the static tiles of a level (walls, platforms, breakable walls).
+// The level is split into chunks of CHUNK_COLUMNS columns; each chunk keeps one vertex
+// array per texture, built once and only rebuilt when one of its cells changes.
+// Drawing costs one draw call per texture per visible chunk (one per chunk with the atlas).
+// Chunks live in slots sized to the grid's stored columns, so a streamed level only
+// keeps vertices for its resident window; a slot is rebuilt when a different chunk
+// scrolls into it.
+class TileMapRenderer {
+public:
+    static const int CHUNK_COLUMNS = 16;
+
+private:
+    struct TileStyle {
+        TileType tile;
+        TextureRegion region;
+    };
+
+    struct Batch {
+        const Texture* texture;
+        VertexArray vertices;
+    };
+
+    struct Chunk {
+        vector<Batch> batches;
+        int index;     // Level chunk held in this slot (-1 = none)
+        bool dirty;
+    };
+
+    vector<TileStyle> styles;
+    vector<Chunk> chunks;
+    int chunkCount;     // Chunks across the whole level
+    const TileGrid* grid;
+    int width;
+    int height;
+    float cellSize;
+    int drawCalls;
+
+    const TileStyle* findStyle(TileType tile) const {
+        for (size_t i = 0; i < styles.size(); i++) {
+            if (styles[i].tile == tile) return &styles[i];
+        }
+        return nullptr;
+    }
+
+    void appendQuad(VertexArray& vertices, int col, int row, const IntRect& rect) {
+        float left = col * cellSize;
+        float top = row * cellSize;
+        float u = static_cast<float>(rect.left);
+        float v = static_cast<float>(rect.top);
+        float uw = static_cast<float>(rect.width);
+        float vh = static_cast<float>(rect.height);
+
+        vertices.append(Vertex(Vector2f(left, top), Vector2f(u, v)));
+        vertices.append(Vertex(Vector2f(left + cellSize, top), Vector2f(u + uw, v)));
+        vertices.append(Vertex(Vector2f(left + cellSize, top + cellSize), Vector2f(u + uw, v + vh)));
+        vertices.append(Vertex(Vector2f(left, top + cellSize), Vector2f(u, v + vh)));
+    }
+
+    Chunk& slotFor(int index) { return chunks[index % chunks.size()]; }
+
+    void rebuildChunk(int index) {
+        Chunk& chunk = slotFor(index);
+        for (size_t i = 0; i < chunk.batches.size(); i++) {
+            chunk.batches[i].vertices.clear();
+        }
+        chunk.index = index;
+
+        int startCol = index * CHUNK_COLUMNS;
+        int endCol = min(width, startCol + CHUNK_COLUMNS);
+        for (int col = startCol; col < endCol; col++) {
+            if (!grid->isResident(col)) continue;
+            const unsigned char* column = grid->column(col);
+            for (int row = 0; row < height; row++) {
+                const TileStyle* style = findStyle(TileGrid::typeOf(column[row]));
+                if (!style || !style->region.texture) continue;
+
+                // Find (or start) the batch for this tile's texture
+                Batch* batch = nullptr;
+                for (size_t i = 0; i < chunk.batches.size(); i++) {
+                    if (chunk.batches[i].texture == style->region.texture.get()) {
+                        batch = &chunk.batches[i];
+                        break;
+                    }
+                }
+                if (!batch) {
+                    Batch newBatch;
+                    newBatch.texture = style->region.texture.get();
+                    newBatch.vertices.setPrimitiveType(Quads);
+                    chunk.batches.push_back(newBatch);
+                    batch = &chunk.batches.back();
+                }
+                appendQuad(batch->vertices, col, row, style->region.rect);
+            }
+        }
+        chunk.dirty = false;
+    }
+
+public:
+    TileMapRenderer() : chunkCount(0), grid(nullptr), width(0), height(0), cellSize(0), drawCalls(0) {}
+
+    // Register the texture used for a tile type
+    void setTileTexture(TileType tile, const TextureRegion& region) {
+        for (size_t i = 0; i < styles.size(); i++) {
+            if (styles[i].tile == tile) {
+                styles[i].region = region;
+                markAllDirty();
+                return;
+            }
+        }
+        TileStyle style;
+        style.tile = tile;
+        style.region = region;
+        styles.push_back(style);
+        markAllDirty();
+    }
+
+    bool isDrawnTile(TileType tile) const {
+        return findStyle(tile) != nullptr;
+    }
+
+    // Build the chunks for a level grid; called whenever the level is (re)created.
+    // Chunks of a streamed grid are built as they are first drawn.
+    void build(const TileGrid* tiles, float levelCellSize) {
+        grid = tiles;
+        width = tiles->getWidth();
+        height = tiles->getHeight();
+        cellSize = levelCellSize;
+        chunkCount = (width + CHUNK_COLUMNS - 1) / CHUNK_COLUMNS;
+        int slots = min(chunkCount, (tiles->getStoredColumns() + CHUNK_COLUMNS - 1) / CHUNK_COLUMNS);
+        Chunk empty;
+        empty.index = -1;
+        empty.dirty = true;
+        chunks.assign(max(slots, 1), empty);
+        for (int i = 0; i < slots && tiles->isResident(i * CHUNK_COLUMNS); i++) {
+            rebuildChunk(i);
+        }
+    }
+
+    // Flag the chunk holding a column for rebuilding on its next draw
+    void markDirty(int col) {
+        int index = col / CHUNK_COLUMNS;
+        if (col >= 0 && index < chunkCount && !chunks.empty() && slotFor(index).index == index) {
+            slotFor(index).dirty = true;
+        }
+    }
+
+    void markAllDirty() {
+        for (size_t i = 0; i < chunks.size(); i++) {
+            chunks[i].dirty = true;
+        }
+    }
+
+    void draw(RenderWindow& window, float camera_offset_x, int screenWidth) {
+        drawCalls = 0;
+        if (!grid || chunkCount == 0) return;
+
+        int startChunk = max(0, static_cast<int>(camera_offset_x / cellSize) / CHUNK_COLUMNS);
+        int endChunk = min(chunkCount - 1,
+            static_cast<int>((camera_offset_x + screenWidth) / cellSize) / CHUNK_COLUMNS);
+
+        RenderStates states;
+        states.transform.translate(-camera_offset_x, 0);
+
+        for (int i = startChunk; i <= endChunk; i++) {
+            Chunk& chunk = slotFor(i);
+            if (chunk.index != i || chunk.dirty) {
+                rebuildChunk(i);
+            }
+            for (size_t b = 0; b < chunk.batches.size(); b++) {
+                const Batch& batch = chunk.batches[b];
+                if (batch.vertices.getVertexCount() == 0) continue;
+                states.texture = batch.texture;
+                window.draw(batch.vertices, states);
+                drawCalls++;
+            }
+        }
+    }
+
+    // Copy the vertices of the chunks overlapping [minX, maxX) into a snapshot
+    void capture(RenderSnapshot& snapshot, float minX, float maxX) {
+        if (!grid || chunkCount == 0) return;
+
+        int startChunk = max(0, static_cast<int>(minX / cellSize) / CHUNK_COLUMNS);
+        int endChunk = min(chunkCount - 1, static_cast<int>(maxX / cellSize) / CHUNK_COLUMNS);
+        for (int i = startChunk; i <= endChunk; i++) {
+            Chunk& chunk = slotFor(i);
+            if (chunk.index != i || chunk.dirty) {
+                rebuildChunk(i);
+            }
+            for (size_t b = 0; b < chunk.batches.size(); b++) {
+                if (chunk.batches[b].vertices.getVertexCount() > 0) {
+                    snapshot.addTiles(chunk.batches[b].texture, chunk.batches[b].vertices);
+                }
+            }
+        }
+    }
+
+    int getChunkCount() const { return chunkCount; }
+    int getLastDrawCalls() const { return drawCalls; }
+};
+
+#endif // TILE_MAP_RENDERER_H
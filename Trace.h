@@ -0,0 +1,238 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+// Session tracing in Chrome's trace_event JSON format (open the file in Perfetto or
+// chrome://tracing). Code is instrumented with the macros below:
+//
+//     TRACE_SCOPE("load", "LabyrinthZone");                // span of the enclosing block
+//     TRACE_SCOPE_DETAIL("load", "texture", filename);     // same, with a string argument
+//     TRACE_INSTANT("level", "transition started");        // single point in time
+//
+// Names and categories must be string literals (they are stored as pointers); details
+// are copied. Recording only happens between Trace::start() and Trace::stop(); until
+// then each macro costs one relaxed atomic load. Build with SONIC_TRACE=0 to compile
+// them out entirely.
+//
+// Every thread records into its own buffer, a list of fixed-size chunks that only that
+// thread writes; each chunk publishes its event count with a release store. writeJson
+// reads the published events of every buffer without locks, so it can run while other
+// threads are still recording.
+
+#ifndef SONIC_TRACE
+#define SONIC_TRACE 1
+#endif
+
+struct TraceEvent {
+    const char* name;
+    const char* category;
+    long long startNs;      // Since Trace::start()
+    long long durationNs;   // Complete ('X') events only
+    char phase;             // 'X' complete, 'i' instant
+    char detail[47];        // Optional argument, truncated
+};
+
+class Trace {
+private:
+    typedef chrono::steady_clock TraceClock;
+
+    static const int CHUNK_EVENTS = 2048;
+
+    struct Chunk {
+        TraceEvent events[CHUNK_EVENTS];
+        atomic<int> count;
+        atomic<Chunk*> next;
+        Chunk() : count(0), next(nullptr) {}
+    };
+
+    // One per thread that has recorded anything; never freed, so a thread's events
+    // outlive it until the trace is written
+    struct Buffer {
+        Chunk* first;
+        Chunk* last;        // Only touched by the owning thread
+        int threadId;
+        atomic<const char*> threadName;
+        Buffer* next;       // Fixed before the buffer is published
+    };
+
+    inline static atomic<bool> enabled{ false };
+    inline static atomic<Buffer*> buffers{ nullptr };
+    inline static atomic<int> nextThreadId{ 1 };
+    inline static TraceClock::time_point epoch;
+
+    static Buffer*& localBuffer() {
+        thread_local Buffer* buffer = nullptr;
+        return buffer;
+    }
+
+    // This thread's buffer, created and pushed onto the list on first use
+    static Buffer* threadBuffer() {
+        Buffer*& buffer = localBuffer();
+        if (!buffer) {
+            buffer = new Buffer();
+            buffer->first = buffer->last = new Chunk();
+            buffer->threadId = nextThreadId.fetch_add(1);
+            buffer->threadName.store(nullptr);
+            buffer->next = buffers.load(memory_order_relaxed);
+            while (!buffers.compare_exchange_weak(buffer->next, buffer, memory_order_release, memory_order_relaxed)) {
+            }
+        }
+        return buffer;
+    }
+
+    static void record(char phase, const char* category, const char* name, long long startNs, long long durationNs, const char* detail) {
+        Buffer* buffer = threadBuffer();
+        Chunk* chunk = buffer->last;
+        int index = chunk->count.load(memory_order_relaxed);
+        if (index == CHUNK_EVENTS) {
+            Chunk* fresh = new Chunk();
+            chunk->next.store(fresh, memory_order_release);
+            buffer->last = chunk = fresh;
+            index = 0;
+        }
+        TraceEvent& event = chunk->events[index];
+        event.name = name;
+        event.category = category;
+        event.startNs = startNs;
+        event.durationNs = durationNs;
+        event.phase = phase;
+        event.detail[0] = '\0';
+        if (detail) {
+            strncpy(event.detail, detail, sizeof(event.detail) - 1);
+            event.detail[sizeof(event.detail) - 1] = '\0';
+        }
+        chunk->count.store(index + 1, memory_order_release);
+    }
+
+    static void writeEscaped(ostream& out, const char* text) {
+        for (; *text; text++) {
+            if (*text == '"' || *text == '\\') out << '\\';
+            if (static_cast<unsigned char>(*text) >= 0x20) out << *text;
+        }
+    }
+
+public:
+    static long long nowNs() {
+        return chrono::duration_cast<chrono::nanoseconds>(TraceClock::now() - epoch).count();
+    }
+    static long long toNs(TraceClock::time_point time) {
+        return chrono::duration_cast<chrono::nanoseconds>(time - epoch).count();
+    }
+
+    // Start recording; timestamps count from here
+    static void start() {
+        epoch = TraceClock::now();
+        enabled.store(true);
+    }
+    static void stop() { enabled.store(false); }
+    static bool isEnabled() { return enabled.load(memory_order_relaxed); }
+
+    // Name shown for the calling thread's track
+    static void setThreadName(const char* name) {
+        threadBuffer()->threadName.store(name, memory_order_release);
+    }
+
+    static void complete(const char* category, const char* name, long long startNs, long long endNs, const char* detail = nullptr) {
+        record('X', category, name, startNs, endNs - startNs, detail);
+    }
+    static void instant(const char* category, const char* name, const char* detail = nullptr) {
+        if (isEnabled()) record('i', category, name, nowNs(), 0, detail);
+    }
+
+    // Every event published so far, as a trace_event JSON file
+    static bool writeJson(const string& filename) {
+        ofstream out(filename);
+        if (!out.is_open()) {
+            cout << "Failed to write trace: " << filename << endl;
+            return false;
+        }
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool firstEvent = true;
+        char numbers[96];
+        for (Buffer* buffer = buffers.load(memory_order_acquire); buffer; buffer = buffer->next) {
+            const char* threadName = buffer->threadName.load(memory_order_acquire);
+            if (threadName) {
+                out << (firstEvent ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+                    << buffer->threadId << ",\"args\":{\"name\":\"";
+                writeEscaped(out, threadName);
+                out << "\"}}";
+                firstEvent = false;
+            }
+            for (Chunk* chunk = buffer->first; chunk; chunk = chunk->next.load(memory_order_acquire)) {
+                int count = chunk->count.load(memory_order_acquire);
+                for (int i = 0; i < count; i++) {
+                    const TraceEvent& event = chunk->events[i];
+                    out << (firstEvent ? "" : ",") << "\n{\"name\":\"";
+                    writeEscaped(out, event.name);
+                    out << "\",\"cat\":\"";
+                    writeEscaped(out, event.category);
+                    if (event.phase == 'X') {
+                        snprintf(numbers, sizeof(numbers), "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f", event.startNs / 1000.0, event.durationNs / 1000.0);
+                    }
+                    else {
+                        snprintf(numbers, sizeof(numbers), "\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f", event.startNs / 1000.0);
+                    }
+                    out << numbers << ",\"pid\":1,\"tid\":" << buffer->threadId;
+                    if (event.detail[0]) {
+                        out << ",\"args\":{\"detail\":\"";
+                        writeEscaped(out, event.detail);
+                        out << "\"}";
+                    }
+                    out << "}";
+                    firstEvent = false;
+                }
+            }
+        }
+        out << "\n]}\n";
+        return true;
+    }
+};
+
+// Records the lifetime of a block as one complete event
+class TraceScope {
+private:
+    const char* category;
+    const char* name;
+    const char* detail;
+    long long startNs;
+    bool active;
+
+public:
+    TraceScope(const char* category_, const char* name_, const char* detail_ = nullptr)
+        : category(category_), name(name_), detail(detail_), startNs(0), active(Trace::isEnabled()) {
+        if (active) startNs = Trace::nowNs();
+    }
+    ~TraceScope() {
+        if (active) Trace::complete(category, name, startNs, Trace::nowNs(), detail);
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#if SONIC_TRACE
+#define TRACE_ENABLED() Trace::isEnabled()
+#define TRACE_SCOPE(category, name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(category, name)
+#define TRACE_SCOPE_DETAIL(category, name, detail) TraceScope TRACE_CONCAT(traceScope, __LINE__)(category, name, detail)
+#define TRACE_INSTANT(category, name) Trace::instant(category, name)
+#define TRACE_THREAD_NAME(name) Trace::setThreadName(name)
+#else
+#define TRACE_ENABLED() false
+#define TRACE_SCOPE(category, name) ((void)0)
+#define TRACE_SCOPE_DETAIL(category, name, detail) ((void)0)
+#define TRACE_INSTANT(category, name) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#endif
+
+#endif // TRACE_H
@@ -0,0 +1,52 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+
+using namespace std;
+
+// Hands values from one producer thread to one consumer thread without locks or
+// waiting. The producer fills writeBuffer() and publishes it; the consumer takes the
+// most recently published value with acquireLatest() and reads it through readBuffer()
+// until its next acquire. A third, shared slot sits between the two, so neither side
+// ever touches the slot the other one is using; values the consumer didn't get to in
+// time are simply overwritten.
+template <typename T>
+class TripleBuffer {
+private:
+    static const int INDEX_MASK = 3;
+    static const int FRESH = 4;     // Set in 'shared' while it holds an unread value
+
+    T slots[3];
+    atomic<int> shared;     // Index of the slot between the threads, plus FRESH
+    int writeIndex;         // Producer only
+    int readIndex;          // Consumer only
+
+public:
+    TripleBuffer() : shared(1), writeIndex(0), readIndex(2) {}
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Producer: the slot to fill. It still holds whatever was last written to it.
+    T& writeBuffer() { return slots[writeIndex]; }
+
+    // Producer: make the filled slot the latest value and get a free one back
+    void publish() {
+        writeIndex = shared.exchange(writeIndex | FRESH, memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Consumer: switch to the latest published value. Returns false (and keeps the
+    // current one) if nothing was published since the last call.
+    bool acquireLatest() {
+        if (!(shared.load(memory_order_relaxed) & FRESH)) return false;
+        readIndex = shared.exchange(readIndex, memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    // Consumer: the value taken by the last successful acquireLatest(). The consumer
+    // owns it until then, so it may also tidy it up.
+    const T& readBuffer() const { return slots[readIndex]; }
+    T& readBuffer() { return slots[readIndex]; }
+};
+
+#endif // TRIPLE_BUFFER_H
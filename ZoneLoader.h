@@ -0,0 +1,210 @@
+#ifndef ZONE_LOADER_H
+#define ZONE_LOADER_H
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TextureCache.h"
+#include "Trace.h"
+
+using namespace sf;
+using namespace std;
+
+// Loads a zone's images ahead of time without stalling a frame. File reads and image
+// decodes run on a background thread (started on the first request); GPU uploads must
+// happen on the main thread, so pump() does them a strip of rows at a time within a
+// time budget. Each finished texture goes into the TextureCache, and the job keeps a
+// handle to it until release(), so the zone's constructor only hits the cache.
+class ZoneLoader {
+public:
+    static constexpr unsigned UPLOAD_ROWS = 64;   // Rows of an image uploaded per slice
+
+private:
+    typedef chrono::steady_clock LoadClock;
+
+    struct PendingImage {
+        string filename;
+        Image image;             // Written by the worker, read once decoded
+        bool loaded;
+        TextureHandle texture;
+        unsigned uploadedRows;
+    };
+
+    struct Job {
+        vector<PendingImage> images;    // Fixed once queued
+        size_t decodedCount;            // Guarded by the lock
+        size_t uploadIndex;             // Main thread only
+    };
+
+    map<int, unique_ptr<Job>> jobs;     // Main thread only
+    deque<Job*> queue;
+    mutex lock;
+    condition_variable workAvailable;
+    condition_variable imageDecoded;
+    thread worker;
+    bool stopping;
+
+    void workerLoop() {
+        TRACE_THREAD_NAME("zone loader");
+        unique_lock<mutex> guard(lock);
+        while (true) {
+            workAvailable.wait(guard, [this] { return stopping || !queue.empty(); });
+            if (stopping) return;
+            Job* job = queue.front();
+            queue.pop_front();
+            for (size_t i = 0; i < job->images.size() && !stopping; i++) {
+                PendingImage& pending = job->images[i];
+                guard.unlock();
+                bool loaded;
+                {
+                    TRACE_SCOPE_DETAIL("load", "decode", pending.filename.c_str());
+                    loaded = pending.image.loadFromFile(pending.filename);
+                }
+                guard.lock();
+                pending.loaded = loaded;
+                job->decodedCount++;
+                imageDecoded.notify_all();
+            }
+        }
+    }
+
+    Job* findJob(int zone) {
+        map<int, unique_ptr<Job>>::iterator it = jobs.find(zone);
+        return it != jobs.end() ? it->second.get() : nullptr;
+    }
+
+    bool isDecoded(Job& job) {
+        lock_guard<mutex> guard(lock);
+        return job.decodedCount > job.uploadIndex;
+    }
+
+    // Upload the next strip of the job's current (decoded) image; a finished image
+    // goes into the cache and its decoded copy is dropped
+    void uploadSlice(Job& job) {
+        TRACE_SCOPE("load", "upload slice");
+        PendingImage& pending = job.images[job.uploadIndex];
+        Vector2u size = pending.image.getSize();
+        if (!pending.texture) {
+            pending.texture = make_shared<Texture>();
+            if (pending.loaded && !pending.texture->create(size.x, size.y)) {
+                pending.loaded = false;
+            }
+        }
+        if (pending.loaded && pending.uploadedRows < size.y) {
+            unsigned rows = min(UPLOAD_ROWS, size.y - pending.uploadedRows);
+            const Uint8* pixels = pending.image.getPixelsPtr() + static_cast<size_t>(pending.uploadedRows) * size.x * 4;
+            pending.texture->update(pixels, size.x, rows, 0, pending.uploadedRows);
+            pending.uploadedRows += rows;
+            if (pending.uploadedRows < size.y) return;
+        }
+        TextureCache::getInstance().adopt(pending.filename, pending.texture, pending.loaded);
+        pending.image = Image();
+        job.uploadIndex++;
+    }
+
+public:
+    ZoneLoader() : stopping(false) {}
+    ZoneLoader(const ZoneLoader&) = delete;
+    ZoneLoader& operator=(const ZoneLoader&) = delete;
+
+    ~ZoneLoader() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        if (worker.joinable()) worker.join();
+    }
+
+    // Start loading a zone's images (atlas pages where the atlas has them); files the
+    // cache already holds are skipped. Does nothing if the zone was already requested.
+    void request(int zone, const vector<string>& files) {
+        if (findJob(zone)) return;
+        unique_ptr<Job> job(new Job());
+        job->decodedCount = 0;
+        job->uploadIndex = 0;
+
+        // Headless runs load no textures, so there is nothing to do
+        TextureCache& cache = TextureCache::getInstance();
+        if (cache.isLoadingEnabled()) {
+            for (size_t i = 0; i < files.size(); i++) {
+                string filename = cache.resolveFile(files[i]);
+                bool queued = false;
+                for (size_t j = 0; j < job->images.size(); j++) {
+                    if (job->images[j].filename == filename) queued = true;
+                }
+                if (queued || cache.isResident(filename)) continue;
+
+                PendingImage pending;
+                pending.filename = filename;
+                pending.loaded = false;
+                pending.uploadedRows = 0;
+                job->images.push_back(pending);
+            }
+        }
+
+        Job* queuedJob = job.get();
+        jobs[zone] = move(job);
+        if (queuedJob->images.empty()) return;
+
+        if (!worker.joinable()) {
+            worker = thread(&ZoneLoader::workerLoop, this);
+        }
+        {
+            lock_guard<mutex> guard(lock);
+            queue.push_back(queuedJob);
+        }
+        workAvailable.notify_one();
+    }
+
+    bool isRequested(int zone) { return findJob(zone) != nullptr; }
+
+    bool isComplete(int zone) {
+        Job* job = findJob(zone);
+        return job && job->uploadIndex == job->images.size();
+    }
+
+    // Main thread: upload decoded images until about budgetMs has been spent.
+    // Returns true once every image of the zone is in the cache.
+    bool pump(int zone, float budgetMs) {
+        Job* job = findJob(zone);
+        if (!job) return false;
+        LoadClock::time_point start = LoadClock::now();
+        while (job->uploadIndex < job->images.size() && isDecoded(*job)) {
+            uploadSlice(*job);
+            if (chrono::duration<float, milli>(LoadClock::now() - start).count() >= budgetMs) break;
+        }
+        return job->uploadIndex == job->images.size();
+    }
+
+    // Main thread: complete a zone's job now, waiting for the worker where it hasn't
+    // decoded an image yet (the zone is needed before the preload could finish)
+    void finish(int zone) {
+        Job* job = findJob(zone);
+        if (!job) return;
+        TRACE_SCOPE("load", "ZoneLoader::finish");
+        while (job->uploadIndex < job->images.size()) {
+            {
+                unique_lock<mutex> guard(lock);
+                imageDecoded.wait(guard, [job] { return job->decodedCount > job->uploadIndex; });
+            }
+            uploadSlice(*job);
+        }
+    }
+
+    // Drop a complete job's texture handles (the zone holds its own by now)
+    void release(int zone) {
+        lock_guard<mutex> guard(lock);
+        jobs.erase(zone);
+    }
+};
+
+#endif // ZONE_LOADER_H
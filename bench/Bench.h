@@ -0,0 +1,202 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Minimal benchmark harness (no dependencies).
+//
+// A benchmark is a function that runs its operation once per keepRunning() pass:
+//
+//     suite.add("Level::reset", [&](BenchState& state) {
+//         while (state.keepRunning()) level.reset();
+//     });
+//
+// Work between pauseTiming() and resumeTiming() is not counted. Each benchmark is
+// first calibrated to take about minTime seconds per run, then run 'repetitions'
+// times; the median time per iteration is the headline number.
+
+// Keep a value (and the work that produced it) from being optimised away
+template <typename T>
+inline void benchKeep(T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile char sink;
+    sink = *reinterpret_cast<volatile char*>(&value);
+#endif
+}
+
+class BenchState {
+private:
+    typedef chrono::steady_clock BenchClock;
+
+    long long iterations;
+    long long remaining;
+    BenchClock::time_point started;
+    BenchClock::duration elapsed;
+    bool running;
+    bool begun;
+
+    void start() {
+        running = true;
+        started = BenchClock::now();
+    }
+
+    void stop() {
+        if (running) elapsed += BenchClock::now() - started;
+        running = false;
+    }
+
+public:
+    explicit BenchState(long long iterationCount)
+        : iterations(iterationCount), remaining(iterationCount), elapsed(BenchClock::duration::zero()), running(false), begun(false) {}
+
+    // True while iterations are left; the clock starts on the first call
+    bool keepRunning() {
+        if (!begun) {
+            begun = true;
+            start();
+        }
+        if (remaining-- > 0) return true;
+        stop();
+        return false;
+    }
+
+    void pauseTiming() { stop(); }
+    void resumeTiming() { start(); }
+
+    long long getIterations() const { return iterations; }
+    double getSeconds() const { return chrono::duration<double>(elapsed).count(); }
+};
+
+struct BenchResult {
+    string name;
+    long long iterations;      // Per repetition
+    int repetitions;
+    double medianNs;           // Per iteration
+    double minNs;
+    double meanNs;
+    double stddevNs;
+};
+
+class BenchSuite {
+private:
+    struct BenchCase {
+        string name;
+        function<void(BenchState&)> run;
+    };
+
+    vector<BenchCase> cases;
+    double minTime;
+    int repetitions;
+
+    static double runOnce(const BenchCase& bench, long long iterations) {
+        BenchState state(iterations);
+        bench.run(state);
+        return state.getSeconds();
+    }
+
+    // Iterations needed for one run to take about minTime
+    long long calibrate(const BenchCase& bench) const {
+        long long iterations = 1;
+        while (true) {
+            double seconds = runOnce(bench, iterations);
+            if (seconds >= minTime / 10 || iterations >= 1000000000LL) {
+                double perIteration = seconds / iterations;
+                long long needed = perIteration > 0 ? static_cast<long long>(minTime / perIteration) : iterations * 10;
+                return max(1LL, min(needed, 1000000000LL));
+            }
+            iterations *= 10;
+        }
+    }
+
+    static string escapeJson(const string& text) {
+        string out;
+        for (size_t i = 0; i < text.size(); i++) {
+            if (text[i] == '"' || text[i] == '\\') out += '\\';
+            out += text[i];
+        }
+        return out;
+    }
+
+public:
+    BenchSuite() : minTime(0.1), repetitions(5) {}
+
+    void setMinTime(double seconds) { minTime = seconds; }
+    void setRepetitions(int count) { repetitions = max(1, count); }
+
+    void add(const string& name, function<void(BenchState&)> run) {
+        BenchCase bench = { name, run };
+        cases.push_back(bench);
+    }
+
+    // Run every benchmark whose name contains filter, printing a line for each
+    vector<BenchResult> run(const string& filter, ostream& log) const {
+        vector<BenchResult> results;
+        char line[256];
+        snprintf(line, sizeof(line), "%-52s %14s %14s %12s", "benchmark", "median ns/op", "min ns/op", "iterations");
+        log << line << endl;
+        for (size_t c = 0; c < cases.size(); c++) {
+            const BenchCase& bench = cases[c];
+            if (!filter.empty() && bench.name.find(filter) == string::npos) continue;
+
+            long long iterations = calibrate(bench);
+            vector<double> samples;
+            for (int r = 0; r < repetitions; r++) {
+                samples.push_back(runOnce(bench, iterations) * 1e9 / iterations);
+            }
+            sort(samples.begin(), samples.end());
+
+            BenchResult result;
+            result.name = bench.name;
+            result.iterations = iterations;
+            result.repetitions = repetitions;
+            result.medianNs = samples[samples.size() / 2];
+            result.minNs = samples[0];
+            double sum = 0, squares = 0;
+            for (size_t i = 0; i < samples.size(); i++) sum += samples[i];
+            result.meanNs = sum / samples.size();
+            for (size_t i = 0; i < samples.size(); i++) squares += (samples[i] - result.meanNs) * (samples[i] - result.meanNs);
+            result.stddevNs = sqrt(squares / samples.size());
+            results.push_back(result);
+
+            snprintf(line, sizeof(line), "%-52s %14.1f %14.1f %12lld", result.name.c_str(), result.medianNs, result.minNs, result.iterations);
+            log << line << endl;
+        }
+        return results;
+    }
+
+    // Results as JSON; 'context' entries (key, value) describe the build and machine
+    static void writeJson(ostream& out, const vector<BenchResult>& results, const vector<pair<string, string>>& context) {
+        char date[64];
+        time_t now = time(nullptr);
+        strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+        out << "{\n  \"context\": {\n    \"date\": \"" << date << "\"";
+        for (size_t i = 0; i < context.size(); i++) {
+            out << ",\n    \"" << escapeJson(context[i].first) << "\": \"" << escapeJson(context[i].second) << "\"";
+        }
+        out << "\n  },\n  \"benchmarks\": [";
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchResult& r = results[i];
+            char numbers[256];
+            snprintf(numbers, sizeof(numbers),
+                "\"iterations\": %lld, \"repetitions\": %d, \"median_ns\": %.3f, \"min_ns\": %.3f, \"mean_ns\": %.3f, \"stddev_ns\": %.3f",
+                r.iterations, r.repetitions, r.medianNs, r.minNs, r.meanNs, r.stddevNs);
+            out << (i ? "," : "") << "\n    {\"name\": \"" << escapeJson(r.name) << "\", " << numbers << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+};
+
+#endif // BENCH_H
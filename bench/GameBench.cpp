@@ -0,0 +1,251 @@
+// Benchmarks of the game's hot paths.
+//
+// Runs without a window, audio or textures (like Headless.cpp) and times level
+// loading, resets, collision checks, enemy and player updates. Results print as a
+// table; --json writes them in a form meant to be kept per release and compared.
+//
+// Usage: sonic-bench [--filter text] [--json file] [--min-time seconds] [--repetitions N]
+//   --filter       only run benchmarks whose name contains text
+//   --json         also write the results as JSON to file ("-" for stdout)
+//   --min-time     seconds per timed run (default 0.1)
+//   --repetitions  timed runs per benchmark; the median is reported (default 5)
+//
+// Run it from the game directory (the one containing Data/).
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include "Bench.h"
+#include "../AudioManager.h"
+#include "../TextureCache.h"
+#include "../CollisionBatch.h"
+#include "../GameSimulation.h"
+#include "../Levels.h"
+
+using namespace sf;
+using namespace std;
+
+// Zone 1 with its protected loading and item arrays opened up to the benchmarks
+class BenchZone : public LabyrinthZone {
+public:
+    BenchZone(ScoreManager* scoreMgr, HealthManager* healthMgr) : LabyrinthZone(scoreMgr, healthMgr) {}
+
+    using Level::loadLayoutFromFile;
+
+    // Replace every collectible with rings at the given positions
+    void setRings(const vector<Vector2f>& positions) {
+        ringStore.clear();
+        extraLifeStore.clear();
+        boostStore.clear();
+        for (size_t i = 0; i < positions.size(); i++) {
+            ringStore.push_back(Ring(positions[i].x, positions[i].y, scoreManager));
+        }
+        rebuildItemIndex();
+    }
+};
+
+class BenchSonic : public Sonic {
+public:
+    BenchSonic(float x, float y, HealthManager* healthMgr) : Sonic(x, y, healthMgr) {}
+
+    using Player::handleCollisions;
+};
+
+static void printUsage() {
+    cout << "Usage: sonic-bench [--filter text] [--json file] [--min-time seconds] [--repetitions N]" << endl;
+}
+
+template <typename Zone>
+static void addZoneBenchmarks(BenchSuite& suite, const string& name, ScoreManager& score, HealthManager& health) {
+    suite.add(name + "::createLevel", [&score, &health](BenchState& state) {
+        Zone zone(&score, &health);
+        while (state.keepRunning()) {
+            zone.createLevel();
+        }
+    });
+    suite.add(name + "::reset", [&score, &health](BenchState& state) {
+        Zone zone(&score, &health);
+        while (state.keepRunning()) {
+            zone.reset();
+        }
+    });
+}
+
+// Rings scattered over the whole level; the player sweeps through the middle and
+// collects the ones in its way on the first pass, after which it only passes near them
+static void addSpreadRingBenchmark(BenchSuite& suite, int count, ScoreManager& score, HealthManager& health) {
+    suite.add("Level::checkCollectibleCollisions/spread/" + to_string(count), [count, &score, &health](BenchState& state) {
+        BenchZone zone(&score, &health);
+        mt19937 rng(count);
+        float levelWidth = zone.getWidth() * zone.getCellSize();
+        float levelHeight = zone.getHeight() * zone.getCellSize();
+        vector<Vector2f> positions;
+        for (int i = 0; i < count; i++) {
+            positions.push_back(Vector2f(rng() % static_cast<int>(levelWidth), rng() % static_cast<int>(levelHeight)));
+        }
+        zone.setRings(positions);
+
+        float x = 0;
+        float y = levelHeight / 2;
+        while (state.keepRunning()) {
+            zone.checkCollectibleCollisions(x, y, 60.0f, 80.0f);
+            x += 7.0f;
+            if (x > levelWidth) x = 0;
+        }
+    });
+}
+
+// Rings packed into the cells around the player without touching it: every one is
+// a broad phase candidate and goes through the narrow phase on every call
+static void addCrowdedRingBenchmark(BenchSuite& suite, int count, ScoreManager& score, HealthManager& health) {
+    suite.add("Level::checkCollectibleCollisions/crowded/" + to_string(count), [count, &score, &health](BenchState& state) {
+        BenchZone zone(&score, &health);
+        float cell = zone.getCellSize();
+        float px = 10 * cell + 2, py = 5 * cell + 2, pw = 60.0f, ph = 80.0f;
+        mt19937 rng(count);
+        vector<Vector2f> positions;
+        while (static_cast<int>(positions.size()) < count) {
+            float x = 9 * cell + rng() % static_cast<int>(3 * cell);
+            float y = 4 * cell + rng() % static_cast<int>(3 * cell);
+            if (!boxesOverlap(px, py, pw, ph, x, y, 32.0f, 32.0f)) positions.push_back(Vector2f(x, y));
+        }
+        zone.setRings(positions);
+
+        while (state.keepRunning()) {
+            zone.checkCollectibleCollisions(px, py, pw, ph);
+        }
+    });
+}
+
+static void addEnemyBenchmark(BenchSuite& suite, int count, ScoreManager& score, HealthManager& health) {
+    suite.add("EnemyManager::updateAll/" + to_string(count), [count, &score, &health](BenchState& state) {
+        BenchZone zone(&score, &health);
+        EnemyManager* enemies = zone.getEnemyManager();
+        enemies->clear();
+        zone.spawnRandomEnemies(count);
+        float playerX = zone.getWidth() * zone.getCellSize() / 2;
+        float playerY = 600.0f;
+        FloatRect view(playerX - 700.0f, -100.0f, 1400.0f, 1100.0f);
+        while (state.keepRunning()) {
+            enemies->updateAll(SIM_DT, playerX, playerY, view);
+        }
+    });
+}
+
+int main(int argc, char** argv) {
+    string filter;
+    string jsonPath;
+    BenchSuite suite;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--filter") == 0 && hasValue) {
+            filter = argv[++i];
+        }
+        else if (strcmp(argv[i], "--json") == 0 && hasValue) {
+            jsonPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--min-time") == 0 && hasValue) {
+            suite.setMinTime(atof(argv[++i]));
+        }
+        else if (strcmp(argv[i], "--repetitions") == 0 && hasValue) {
+            suite.setRepetitions(atoi(argv[++i]));
+        }
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    // No display, no audio device, the same enemies every run
+    TextureCache::getInstance().setLoadingEnabled(false);
+    AudioManager::disableBeforeUse();
+    Level::setSpawnSeed(1);
+
+    ScoreManager score;
+    HealthManager health;
+
+    suite.add("Level::loadLayoutFromFile/level1", [&score, &health](BenchState& state) {
+        BenchZone zone(&score, &health);
+        while (state.keepRunning()) {
+            zone.loadLayoutFromFile("Data/level1.txt");
+        }
+    });
+
+    addZoneBenchmarks<LabyrinthZone>(suite, "LabyrinthZone", score, health);
+    addZoneBenchmarks<IceCapZone>(suite, "IceCapZone", score, health);
+    addZoneBenchmarks<DeathEggZone>(suite, "DeathEggZone", score, health);
+
+    suite.add("Player::handleCollisions/running", [&score, &health](BenchState& state) {
+        BenchZone zone(&score, &health);
+        PlayerManager players(&health);
+        BenchSonic sonic(0, 0, &health);
+        float groundX, groundY;
+        players.findSafeRespawnPosition(&zone, 20 * zone.getCellSize(), groundX, groundY);
+        while (state.keepRunning()) {
+            sonic.setPosition(groundX, groundY);
+            sonic.setVelocity(10.0f, 1.0f);
+            sonic.handleCollisions(&zone);
+        }
+    });
+
+    const int ringCounts[] = { 10, 100, 1000 };
+    for (int count : ringCounts) addSpreadRingBenchmark(suite, count, score, health);
+    for (int count : ringCounts) addCrowdedRingBenchmark(suite, count, score, health);
+
+    addEnemyBenchmark(suite, 100, score, health);
+    addEnemyBenchmark(suite, 1000, score, health);
+
+    suite.add("PlayerManager::updatePhysics/3 characters", [&score, &health](BenchState& state) {
+        BenchZone zone(&score, &health);
+        PlayerManager players(&health);
+        while (state.keepRunning()) {
+            players.updatePhysics(&zone);
+        }
+    });
+
+    // Pits everywhere along the level, so the search starts from every column
+    suite.add("PlayerManager::findSafeRespawnPosition", [&score, &health](BenchState& state) {
+        BenchZone zone(&score, &health);
+        PlayerManager players(&health);
+        float levelWidth = zone.getWidth() * zone.getCellSize();
+        float pitX = 0;
+        float x, y;
+        while (state.keepRunning()) {
+            players.findSafeRespawnPosition(&zone, pitX, x, y);
+            benchKeep(x);
+            pitX += zone.getCellSize();
+            if (pitX >= levelWidth) pitX = 0;
+        }
+    });
+
+    vector<BenchResult> results = suite.run(filter, cout);
+
+    if (!jsonPath.empty()) {
+        vector<pair<string, string>> context;
+        context.push_back(make_pair("collision_path", CollisionBatch::getPathName(CollisionBatch::getPath())));
+#ifdef __VERSION__
+        context.push_back(make_pair("compiler", __VERSION__));
+#endif
+#ifdef NDEBUG
+        context.push_back(make_pair("assertions", "off"));
+#else
+        context.push_back(make_pair("assertions", "on"));
+#endif
+        if (jsonPath == "-") {
+            BenchSuite::writeJson(cout, results, context);
+        }
+        else {
+            ofstream out(jsonPath);
+            if (!out.is_open()) {
+                cout << "Failed to write " << jsonPath << endl;
+                return 1;
+            }
+            BenchSuite::writeJson(out, results, context);
+        }
+    }
+    return 0;
+}
@@ -2,6 +2,8 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include <iostream>
+#include "AssetPreloader.h"
+#include "StartupTimer.h"
 using namespace std;
 using namespace sf;
 
@@ -18,8 +20,11 @@ private:
     bool soundPlayed;
 
 public:
+    static constexpr const char* LOGO_FILE = "Data/sega-logo.png";
+    static constexpr const char* SOUND_FILE = "Data/Sega.wav";
+
     IntroAnimation(RenderWindow& win) : window(win), currentFrame(0), soundPlayed(false) {
-        if (!segaTexture.loadFromFile("Data/sega-logo.png")) {
+        if (!AssetPreloader::getInstance().loadTexture(LOGO_FILE, segaTexture)) {
             cout << "Error loading sega-logo.png\n";
         }
 
@@ -32,7 +37,7 @@ public:
         segaSprite.setScale(3.5f, 3.5f);
         segaSprite.setPosition(50, 300);
 
-        if (!segaBuffer.loadFromFile("Data/Sega.wav")) {
+        if (!AssetPreloader::getInstance().loadSound(SOUND_FILE, segaBuffer)) {
             cout << "Error loading Sega.wav\n";
         }
         segaSound.setBuffer(segaBuffer);
@@ -64,6 +69,7 @@ public:
             window.clear(Color::White);
             window.draw(segaSprite);
             window.display();
+            StartupTimer::markFirstFrame();
 
             if (currentFrame >= 20) {
                 sleep(seconds(frameDuration));
@@ -77,13 +83,14 @@ public:
 class Game {
 private:
     RenderWindow& window;
-    Font font1, font2, font3, font4;
+    Font font1, font2;
     Text sonic, start_game, help, high_scores, settings, quit, main_text;
     Text difficulty, normal_mode, boss_level, back_to_menu;
     Text title, music, music_state, music_vol, music_volume, sound_eff, sound_eff_state, sound_eff_vol, sound_e_volume, settings_text;
     Text highscore;
     Text level1, level2, level3, levelBack;
     Texture backgroundTexture, help_manual_texture;
+    bool helpManualLoaded;
     Sprite backgroundSprite, help_manual;
     Music bgMusic;
     SoundBuffer menuButtonBuffer;
@@ -106,28 +113,28 @@ private:
     int selectedLevel = 0; // 0 means quit, 1/2/3 for levels
 
 public:
-    Game(RenderWindow& win) : window(win),
+    static constexpr const char* TITLE_FONT_FILE = "Data/Sega.TTF";
+    static constexpr const char* MENU_FONT_FILE = "Data/Johnny Fever.otf";
+    static constexpr const char* BACKGROUND_FILE = "Data/title_screen.gif";
+    static constexpr const char* HELP_MANUAL_FILE = "Data/help-manual.png";
+    static constexpr const char* MUSIC_FILE = "Data/risk.ogg";
+    static constexpr const char* BUTTON_SOUND_FILE = "Data/menubutton.wav";
+
+    Game(RenderWindow& win) : window(win), helpManualLoaded(false),
         currentScreen(MAIN_MENU), main_option(1), game_mode(1),levelOption(1), settings_option(1),
         music_on(true), tmusic_vol(50), sound_e_on(true), sound_e_vol(80) {
+        AssetPreloader& assets = AssetPreloader::getInstance();
 
         // Load SEGA font for title
-        if (!font1.loadFromFile("Data/Sega.TTF")) {
+        if (!assets.loadFont(TITLE_FONT_FILE, font1)) {
             cout << "Error loading Sega.TTF font" << endl;
         }
 
         // Load Johnny Fever font for menu options
-        if (!font2.loadFromFile("Data/Johnny Fever.otf")) {
+        if (!assets.loadFont(MENU_FONT_FILE, font2)) {
             cout << "Error loading Johnny Fever.otf font" << endl;
         }
 
-        if (!font3.loadFromFile("Data/Eating Pasta.ttf")) {
-            cout << "Error loading font3" << endl;
-        }
-
-        if (!font4.loadFromFile("Data/HurmeGeometricSans1.otf")) {
-            cout << "Error loading font4" << endl;
-        }
-
         // Initialize main menu title with SEGA font - large and centered
         sonic.setFont(font1);
         sonic.setString("SONIC CLASSIC HEROES");
@@ -283,12 +290,9 @@ public:
         highscore.setFillColor(Color::White);
 
         // Load textures - using title screen as menu background
-        if (!backgroundTexture.loadFromFile("Data/title_screen.gif")) {
+        if (!assets.loadTexture(BACKGROUND_FILE, backgroundTexture)) {
             cout << "Error loading background texture" << endl;
         }
-        if (!help_manual_texture.loadFromFile("Data/help-manual.png")) {
-            cout << "Error loading help manual texture" << endl;
-        }
         backgroundSprite.setTexture(backgroundTexture);
         // Reduce background opacity by 25% (75% visible = 191 alpha)
         backgroundSprite.setColor(Color(255, 255, 255, 191));
@@ -302,18 +306,15 @@ public:
             (1200.0f - backgroundTexture.getSize().x * scale) / 2.0f,
             (900.0f - backgroundTexture.getSize().y * scale) / 2.0f
         );
-        help_manual.setTexture(help_manual_texture);
-        help_manual.setScale(0.5f, 0.5f);
-        help_manual.setPosition(15, 160);
 
         // Audio
-        if (!bgMusic.openFromFile("Data/risk.ogg")) {
+        if (!bgMusic.openFromFile(MUSIC_FILE)) {
             cout << "Error loading background music" << endl;
         }
         bgMusic.setVolume(tmusic_vol);
         bgMusic.setLoop(true);
 
-        if (!menuButtonBuffer.loadFromFile("Data/menubutton.wav")) {
+        if (!assets.loadSound(BUTTON_SOUND_FILE, menuButtonBuffer)) {
             cout << "Error loading menu button sound" << endl;
         }
         menu_button.setBuffer(menuButtonBuffer);
@@ -332,9 +333,9 @@ public:
             }
             update();
             render();
-            // If a level is selected, close window and return
+            StartupTimer::markInteractive();
+            // If a level is selected, return; the game goes on in the same window
             if (selectedLevel > 0) {
-                window.close();
                 return selectedLevel;
             }
         }
@@ -342,6 +343,18 @@ public:
     }
 
 private:
+    // The help manual is only needed once Help is picked
+    void loadHelpManual() {
+        if (helpManualLoaded) return;
+        helpManualLoaded = true;
+        if (!AssetPreloader::getInstance().loadTexture(HELP_MANUAL_FILE, help_manual_texture)) {
+            cout << "Error loading help manual texture" << endl;
+        }
+        help_manual.setTexture(help_manual_texture);
+        help_manual.setScale(0.5f, 0.5f);
+        help_manual.setPosition(15, 160);
+    }
+
     void handleInput(Keyboard::Key key) {
         if (currentScreen == MAIN_MENU) {
             handleMainMenuInput(key);
@@ -380,6 +393,7 @@ private:
                 levelOption = 1;
                 break;
             case 2: // Help
+                loadHelpManual();
                 break;
             case 3: // High Scores
                 currentScreen = HIGH_SCORES;
@@ -665,6 +679,18 @@ private:
     }
 };
 
+// Start decoding the intro's and menu's assets in the background, the intro's first
+// (the help manual is left until Help is picked)
+inline void requestMenuAssets() {
+    AssetPreloader& assets = AssetPreloader::getInstance();
+    assets.requestImage(IntroAnimation::LOGO_FILE);
+    assets.requestSound(IntroAnimation::SOUND_FILE);
+    assets.requestFont(Game::TITLE_FONT_FILE);
+    assets.requestFont(Game::MENU_FONT_FILE);
+    assets.requestImage(Game::BACKGROUND_FILE);
+    assets.requestSound(Game::BUTTON_SOUND_FILE);
+}
+
 inline int showMenu(sf::RenderWindow& window) {
     IntroAnimation intro(window);
     if (!intro.run()) return 0;
@@ -0,0 +1,209 @@
+// Offline sprite atlas packer.
+//
+// Packs the images listed in a sources file into one or more atlas pages and writes a
+// manifest that SpriteAtlas.h loads at runtime, so sprites that used to live in their
+// own textures all end up on a handful of pages.
+//
+// Usage: atlas_packer [sources file] [output directory] [page size]
+//   defaults: tools/atlas_sources.txt Data/atlas 1024
+//
+// Run it from the game directory (the one containing Data/).
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace sf;
+using namespace std;
+
+// Empty border around every sprite; it is filled by repeating the sprite's edge pixels
+// so scaled sprites never pick up colour from their neighbours
+static const int PADDING = 2;
+
+struct SourceImage {
+    string name;   // Path the game asks for
+    string file;   // Path on disk
+    Image image;
+    int page;
+    int x, y;      // Top-left of the sprite (inside the padding)
+};
+
+struct Shelf {
+    int y;
+    int height;
+    int cursorX;
+};
+
+struct Page {
+    vector<Shelf> shelves;
+    int usedHeight;
+};
+
+static bool readSources(const string& filename, vector<SourceImage>& sources) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cout << "Failed to open sources file: " << filename << endl;
+        return false;
+    }
+
+    string line;
+    while (getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        istringstream in(line);
+        SourceImage source;
+        if (!(in >> source.name)) continue;
+        if (!(in >> source.file)) source.file = source.name;
+
+        if (!source.image.loadFromFile(source.file)) {
+            cout << "Skipping " << source.name << ": could not load " << source.file << endl;
+            continue;
+        }
+        source.page = -1;
+        source.x = source.y = 0;
+        sources.push_back(source);
+    }
+    return true;
+}
+
+// Shelf packing: place each sprite on the first shelf it fits on, open a new shelf
+// (or a new page) when none does
+static bool place(vector<Page>& pages, SourceImage& source, int pageSize) {
+    int w = static_cast<int>(source.image.getSize().x) + PADDING * 2;
+    int h = static_cast<int>(source.image.getSize().y) + PADDING * 2;
+    if (w > pageSize || h > pageSize) {
+        return false;
+    }
+
+    for (size_t p = 0; p < pages.size(); p++) {
+        Page& page = pages[p];
+        for (size_t s = 0; s < page.shelves.size(); s++) {
+            Shelf& shelf = page.shelves[s];
+            if (h <= shelf.height && shelf.cursorX + w <= pageSize) {
+                source.page = static_cast<int>(p);
+                source.x = shelf.cursorX + PADDING;
+                source.y = shelf.y + PADDING;
+                shelf.cursorX += w;
+                return true;
+            }
+        }
+        if (page.usedHeight + h <= pageSize) {
+            Shelf shelf = { page.usedHeight, h, w };
+            page.shelves.push_back(shelf);
+            source.page = static_cast<int>(p);
+            source.x = PADDING;
+            source.y = page.usedHeight + PADDING;
+            page.usedHeight += h;
+            return true;
+        }
+    }
+
+    Page page;
+    Shelf shelf = { 0, h, w };
+    page.shelves.push_back(shelf);
+    page.usedHeight = h;
+    pages.push_back(page);
+    source.page = static_cast<int>(pages.size()) - 1;
+    source.x = PADDING;
+    source.y = PADDING;
+    return true;
+}
+
+static void blit(Image& page, const SourceImage& source) {
+    const Image& image = source.image;
+    int w = static_cast<int>(image.getSize().x);
+    int h = static_cast<int>(image.getSize().y);
+    int pageW = static_cast<int>(page.getSize().x);
+    int pageH = static_cast<int>(page.getSize().y);
+
+    for (int py = -PADDING; py < h + PADDING; py++) {
+        for (int px = -PADDING; px < w + PADDING; px++) {
+            int destX = source.x + px;
+            int destY = source.y + py;
+            if (destX < 0 || destY < 0 || destX >= pageW || destY >= pageH) continue;
+            int srcX = min(max(px, 0), w - 1);
+            int srcY = min(max(py, 0), h - 1);
+            page.setPixel(destX, destY, image.getPixel(srcX, srcY));
+        }
+    }
+}
+
+static int nextPowerOfTwo(int value) {
+    int result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+int main(int argc, char** argv) {
+    string sourcesFile = argc > 1 ? argv[1] : "tools/atlas_sources.txt";
+    string outputDir = argc > 2 ? argv[2] : "Data/atlas";
+    int pageSize = argc > 3 ? atoi(argv[3]) : 1024;
+    if (pageSize <= PADDING * 2) {
+        cout << "Invalid page size" << endl;
+        return 1;
+    }
+
+    vector<SourceImage> sources;
+    if (!readSources(sourcesFile, sources) || sources.empty()) {
+        cout << "Nothing to pack" << endl;
+        return 1;
+    }
+
+    // Tallest first keeps the shelves tight
+    sort(sources.begin(), sources.end(), [](const SourceImage& a, const SourceImage& b) {
+        if (a.image.getSize().y != b.image.getSize().y) return a.image.getSize().y > b.image.getSize().y;
+        return a.image.getSize().x > b.image.getSize().x;
+    });
+
+    vector<Page> pages;
+    for (size_t i = 0; i < sources.size(); i++) {
+        if (!place(pages, sources[i], pageSize)) {
+            cout << "Skipping " << sources[i].name << ": larger than the page size" << endl;
+        }
+    }
+
+    std::error_code ec;
+    filesystem::create_directories(outputDir, ec);
+    ofstream manifest(outputDir + "/atlas.txt");
+    if (!manifest.is_open()) {
+        cout << "Failed to write manifest in " << outputDir << endl;
+        return 1;
+    }
+    manifest << "# Generated by tools/AtlasPacker.cpp from " << sourcesFile << " - do not edit" << endl;
+
+    for (size_t p = 0; p < pages.size(); p++) {
+        Image page;
+        page.create(pageSize, nextPowerOfTwo(pages[p].usedHeight), Color::Transparent);
+        for (size_t i = 0; i < sources.size(); i++) {
+            if (sources[i].page == static_cast<int>(p)) blit(page, sources[i]);
+        }
+
+        ostringstream pagePath;
+        pagePath << outputDir << "/atlas" << p << ".png";
+        if (!page.saveToFile(pagePath.str())) {
+            cout << "Failed to save " << pagePath.str() << endl;
+            return 1;
+        }
+        manifest << "page " << p << " " << pagePath.str() << endl;
+        cout << "Wrote " << pagePath.str() << " (" << page.getSize().x << "x" << page.getSize().y << ")" << endl;
+    }
+
+    int packed = 0;
+    for (size_t i = 0; i < sources.size(); i++) {
+        const SourceImage& source = sources[i];
+        if (source.page < 0) continue;
+        manifest << "sprite " << source.name << " " << source.page << " "
+                 << source.x << " " << source.y << " "
+                 << source.image.getSize().x << " " << source.image.getSize().y << endl;
+        packed++;
+    }
+
+    cout << "Packed " << packed << " sprites onto " << pages.size() << " page(s)" << endl;
+    return 0;
+}
@@ -0,0 +1,110 @@
+// Collision kernel microbenchmark.
+//
+// Times CollisionBatch (see CollisionBatch.h) on every path the CPU supports against
+// the one-pair-at-a-time scalar test it replaces, for a few candidate counts, and
+// checks that all paths report the same hits.
+//
+// Usage: collision_bench [iterations]
+//   default: enough iterations for about 4M box tests per case
+//
+// Build with optimisations (-O2); no SFML needed.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../CollisionBatch.h"
+
+using namespace std;
+
+// Per-pair reference: what the per-class checkCollision calls did before batching
+static int testPairs(float px, float py, float pw, float ph, const BoxArrays& boxes, vector<uint64_t>& hits) {
+    hits.assign(CollisionBatch::maskWords(boxes.size()), 0);
+    int total = 0;
+    for (int i = 0; i < boxes.size(); i++) {
+        if (boxesOverlap(px, py, pw, ph, boxes.x[i], boxes.y[i], boxes.w[i], boxes.h[i])) {
+            hits[i >> 6] |= uint64_t(1) << (i & 63);
+            total++;
+        }
+    }
+    return total;
+}
+
+// Boxes shaped like the game's: 64 px cells over a 14-row level, player-sized queries
+static void makeBoxes(int count, mt19937& rng, BoxArrays& boxes) {
+    uniform_real_distribution<float> xs(0.0f, 64.0f * 24.0f);
+    uniform_real_distribution<float> ys(0.0f, 64.0f * 14.0f);
+    uniform_real_distribution<float> sizes(8.0f, 80.0f);
+    boxes.clear();
+    for (int i = 0; i < count; i++) {
+        boxes.push(xs(rng), ys(rng), sizes(rng), sizes(rng));
+    }
+}
+
+template <typename Test>
+static double timeCase(const BoxArrays& boxes, const vector<float>& queries, int iterations, Test test, long long& checksum) {
+    vector<uint64_t> hits;
+    auto start = chrono::steady_clock::now();
+    for (int it = 0; it < iterations; it++) {
+        for (size_t q = 0; q + 1 < queries.size(); q += 2) {
+            checksum += test(queries[q], queries[q + 1], 64.0f, 96.0f, boxes, hits);
+        }
+    }
+    chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count() / (static_cast<double>(iterations) * (queries.size() / 2) * boxes.size());
+}
+
+int main(int argc, char** argv) {
+    int requestedIterations = argc > 1 ? atoi(argv[1]) : 0;
+    mt19937 rng(12345);
+
+    vector<float> queries;
+    uniform_real_distribution<float> qx(-64.0f, 64.0f * 24.0f);
+    uniform_real_distribution<float> qy(-64.0f, 64.0f * 14.0f);
+    for (int q = 0; q < 64; q++) {
+        queries.push_back(qx(rng));
+        queries.push_back(qy(rng));
+    }
+
+    cout << "path      boxes   ns/box   speedup" << endl;
+    const int counts[] = { 4, 16, 64, 256, 4096 };
+    bool allMatch = true;
+    for (int count : counts) {
+        BoxArrays boxes;
+        makeBoxes(count, rng, boxes);
+        int iterations = requestedIterations > 0 ? requestedIterations : max(1, 4000000 / (count * 64));
+
+        // Every path must find exactly the hits the per-pair test finds
+        vector<uint64_t> expected, actual;
+        for (size_t q = 0; q + 1 < queries.size(); q += 2) {
+            testPairs(queries[q], queries[q + 1], 64.0f, 96.0f, boxes, expected);
+            for (int p = 0; p < COLLISION_PATH_COUNT; p++) {
+                if (!CollisionBatch::setPath(static_cast<CollisionPath>(p))) continue;
+                CollisionBatch::test(queries[q], queries[q + 1], 64.0f, 96.0f, boxes, actual);
+                if (actual != expected) {
+                    cout << "MISMATCH: " << CollisionBatch::getPathName(static_cast<CollisionPath>(p)) << " with " << count << " boxes" << endl;
+                    allMatch = false;
+                }
+            }
+        }
+
+        long long checksum = 0;
+        double pairNs = timeCase(boxes, queries, iterations, testPairs, checksum);
+        printf("%-8s %6d %8.3f %8.2fx\n", "pairs", count, pairNs, 1.0);
+        for (int p = 0; p < COLLISION_PATH_COUNT; p++) {
+            CollisionPath path = static_cast<CollisionPath>(p);
+            if (!CollisionBatch::setPath(path)) continue;
+            double ns = timeCase(boxes, queries, iterations,
+                [](float px, float py, float pw, float ph, const BoxArrays& b, vector<uint64_t>& hits) {
+                    return CollisionBatch::test(px, py, pw, ph, b, hits);
+                }, checksum);
+            printf("%-8s %6d %8.3f %8.2fx\n", CollisionBatch::getPathName(path), count, ns, pairNs / ns);
+        }
+        cout << "  (hits: " << checksum << ")" << endl;
+    }
+    return allMatch ? 0 : 1;
+}
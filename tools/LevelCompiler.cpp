@@ -0,0 +1,154 @@
+// Offline level compiler.
+//
+// Turns text layouts into compiled level files (.lvb, see LevelFormat.h) that the game
+// memory-maps instead of parsing text: a tile section, a packed table of item
+// placements sorted by column, and the zone's physics, with a checksum over it all.
+//
+// Usage: level_compiler [manifest]
+//        level_compiler <layout.txt> <physics preset> <output.lvb>
+//   defaults: tools/levels.txt
+//   presets:  labyrinth, icecap, deathegg (see PhysicsConfig.h)
+//
+// Run it from the game directory (the one containing Data/). Recompile after editing
+// a layout, a physics preset or the format.
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../LayoutStream.h"
+#include "../LevelFormat.h"
+#include "../PhysicsConfig.h"
+#include "../TileGrid.h"
+
+using namespace std;
+
+// Rows read from a layout (the zones are 14 rows tall)
+static const int MAX_ROWS = 64;
+
+static bool isItem(TileType type) {
+    return type == TILE_SPIKE || type == TILE_RING || type == TILE_EXTRA_LIFE || type == TILE_SPECIAL_BOOST;
+}
+
+static bool compileLevel(const string& layoutFile, const string& preset, const string& outputFile) {
+    PhysicsConfig physics;
+    if (!PhysicsConfig::fromPresetName(preset, physics)) {
+        cout << "Unknown physics preset: " << preset << endl;
+        return false;
+    }
+
+    LayoutStream layout;
+    if (!layout.open(layoutFile, MAX_ROWS)) {
+        return false;
+    }
+    int width = layout.getWidth();
+    int height = layout.getRows();
+    if (width == 0 || height == 0) {
+        cout << "Empty layout: " << layoutFile << endl;
+        return false;
+    }
+
+    // Read the layout a block of columns at a time so huge layouts stay cheap
+    vector<unsigned char> tiles(static_cast<size_t>(width) * height, TILE_EMPTY);
+    vector<LevelBlobEntity> entities;
+    vector<char> chars;
+    const int BLOCK_COLUMNS = 4096;
+    for (int first = 0; first < width; first += BLOCK_COLUMNS) {
+        int count = min(BLOCK_COLUMNS, width - first);
+        layout.readColumns(first, count, chars);
+        for (int i = 0; i < count; i++) {
+            for (int row = 0; row < height; row++) {
+                TileType type = TileGrid::fromChar(chars[static_cast<size_t>(i) * height + row]);
+                if (isItem(type)) {
+                    LevelBlobEntity entity = { static_cast<uint32_t>(first + i), static_cast<uint16_t>(row), static_cast<uint16_t>(type) };
+                    entities.push_back(entity);
+                }
+                else {
+                    tiles[static_cast<size_t>(first + i) * height + row] = static_cast<unsigned char>(type);
+                }
+            }
+        }
+    }
+
+    LevelBlobHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LEVEL_BLOB_MAGIC, sizeof(header.magic));
+    header.version = LEVEL_BLOB_VERSION;
+    header.width = static_cast<uint32_t>(width);
+    header.height = static_cast<uint32_t>(height);
+    physics.toArray(header.physics);
+    header.tileOffset = sizeof(LevelBlobHeader);
+    size_t tileEnd = header.tileOffset + tiles.size();
+    header.entityOffset = static_cast<uint32_t>((tileEnd + 3) & ~static_cast<size_t>(3));
+    header.entityCount = static_cast<uint32_t>(entities.size());
+
+    // Everything after the header, padding included, so the checksum covers it all
+    vector<unsigned char> body(header.entityOffset - sizeof(LevelBlobHeader) + entities.size() * sizeof(LevelBlobEntity), 0);
+    copy(tiles.begin(), tiles.end(), body.begin());
+    if (!entities.empty()) {
+        memcpy(&body[header.entityOffset - sizeof(LevelBlobHeader)], &entities[0], entities.size() * sizeof(LevelBlobEntity));
+    }
+    header.checksum = levelBlobChecksum(body.data(), body.size());
+
+    filesystem::path outputPath(outputFile);
+    if (outputPath.has_parent_path()) {
+        filesystem::create_directories(outputPath.parent_path());
+    }
+    ofstream out(outputFile, ios::binary | ios::trunc);
+    if (!out.is_open()) {
+        cout << "Failed to write " << outputFile << endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(body.data()), static_cast<streamsize>(body.size()));
+    if (!out) {
+        cout << "Failed to write " << outputFile << endl;
+        return false;
+    }
+
+    cout << outputFile << ": " << width << "x" << height << ", " << entities.size() << " items, "
+         << sizeof(header) + body.size() << " bytes (" << preset << " physics)" << endl;
+    return true;
+}
+
+// Each manifest line: <layout.txt> <physics preset> <output.lvb>
+static bool compileManifest(const string& manifestFile) {
+    ifstream manifest(manifestFile);
+    if (!manifest.is_open()) {
+        cout << "Failed to open manifest: " << manifestFile << endl;
+        return false;
+    }
+    bool ok = true;
+    string line;
+    while (getline(manifest, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        istringstream in(line);
+        string layoutFile, preset, outputFile;
+        if (!(in >> layoutFile >> preset >> outputFile)) {
+            cout << "Skipping malformed line: " << line << endl;
+            ok = false;
+            continue;
+        }
+        ok = compileLevel(layoutFile, preset, outputFile) && ok;
+    }
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    bool ok;
+    if (argc == 4) {
+        ok = compileLevel(argv[1], argv[2], argv[3]);
+    }
+    else if (argc <= 2) {
+        ok = compileManifest(argc == 2 ? argv[1] : "tools/levels.txt");
+    }
+    else {
+        cout << "Usage: level_compiler [manifest] | <layout.txt> <physics preset> <output.lvb>" << endl;
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
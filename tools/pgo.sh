@@ -0,0 +1,43 @@
+#!/bin/sh
+# Profile-guided optimised build.
+#
+# 1. Builds instrumented binaries (SONIC_PGO=GENERATE).
+# 2. Trains them: the game and the headless runner play Data/replays/pgo_training.txt
+#    in every zone, and the benchmarks run once.
+# 3. Rebuilds the same tree with the collected profile (SONIC_PGO=USE).
+#
+# Usage: tools/pgo.sh [build dir]   (default: build/pgo; run from the source directory)
+# Extra CMake arguments can be passed in CMAKE_ARGS, e.g. CMAKE_ARGS=-DCMAKE_CXX_COMPILER=clang++
+
+set -e
+BUILD_DIR=${1:-build/pgo}
+case "$BUILD_DIR" in
+    /*) PROFILE_DIR="$BUILD_DIR/pgo" ;;
+    *) PROFILE_DIR="$(pwd)/$BUILD_DIR/pgo" ;;
+esac
+REPLAY=Data/replays/pgo_training.txt
+
+rm -rf "$PROFILE_DIR"
+cmake -S . -B "$BUILD_DIR" -DCMAKE_BUILD_TYPE=Release -DSONIC_PGO=GENERATE -DSONIC_PGO_DIR="$PROFILE_DIR" $CMAKE_ARGS
+cmake --build "$BUILD_DIR" -j
+
+if [ ! -x "$BUILD_DIR/sonic-headless" ]; then
+    echo "SFML not found: nothing to train" >&2
+    exit 1
+fi
+
+for level in 1 2 3; do
+    "$BUILD_DIR/sonic-heroes" --replay "$REPLAY" --level "$level" > /dev/null
+    "$BUILD_DIR/sonic-headless" --replay "$REPLAY" --level "$level" --quiet > /dev/null
+done
+"$BUILD_DIR/sonic-bench" --min-time 0.02 --repetitions 1 > /dev/null
+
+# Clang writes raw profiles that have to be merged; GCC's are used as they are
+if ls "$PROFILE_DIR"/*.profraw > /dev/null 2>&1; then
+    PROFDATA=${LLVM_PROFDATA:-llvm-profdata}
+    "$PROFDATA" merge -o "$PROFILE_DIR/sonic.profdata" "$PROFILE_DIR"/*.profraw
+fi
+
+cmake -S . -B "$BUILD_DIR" -DSONIC_PGO=USE
+cmake --build "$BUILD_DIR" -j
+echo "Profile-guided binaries are in $BUILD_DIR"